@@ -129,6 +129,76 @@ static std::pair<int, int> changedTicksRange(const CmdState& cmdState, const std
     return { startTick, endTick };
 }
 
+//---------------------------------------------------------
+//   collectChangedScores
+//    returns false if the command doesn't tell which scores it changes,
+//    or changes the staff/measure structure the links between scores
+//    are written relative to
+//---------------------------------------------------------
+
+static bool collectChangedScores(const UndoCommand* command, std::set<Score*>& scores)
+{
+    const std::vector<const EngravingObject*> objects = command->objectItems();
+    if (objects.empty()) {
+        return false;
+    }
+
+    for (const EngravingObject* object : objects) {
+        if (!object || !object->score()) {
+            return false;
+        }
+
+        switch (object->type()) {
+        case ElementType::PART:
+        case ElementType::STAFF:
+        case ElementType::MEASURE:
+        case ElementType::HBOX:
+        case ElementType::VBOX:
+        case ElementType::TBOX:
+        case ElementType::FBOX:
+            return false;
+        default:
+            break;
+        }
+
+        scores.insert(object->score());
+    }
+
+    for (const UndoCommand* child : command->commands()) {
+        if (!collectChangedScores(child, scores)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void updateRevisions(MasterScore* masterScore, const UndoMacro* macro)
+{
+    if (!macro) {
+        return;
+    }
+
+    std::set<Score*> scores;
+    for (const UndoCommand* command : macro->commands()) {
+        if (!collectChangedScores(command, scores)) {
+            scores.clear();
+            break;
+        }
+    }
+
+    if (scores.empty()) {
+        for (Score* score : masterScore->scoreList()) {
+            score->updateRevision();
+        }
+        return;
+    }
+
+    for (Score* score : scores) {
+        score->updateRevision();
+    }
+}
+
 //---------------------------------------------------------
 //    For use with Score::scanElements.
 //    Reset positions and autoplacement for the given
@@ -357,9 +427,11 @@ void Score::undoRedo(bool undo, EditData* ed)
 
     cmdState().reset();
     if (undo) {
+        updateRevisions(masterScore(), undoStack()->last());
         undoStack()->undo(ed);
     } else {
         undoStack()->redo(ed);
+        updateRevisions(masterScore(), undoStack()->last());
     }
     update(false);
     masterScore()->setPlaylistDirty();    // TODO: flag all individual operations
@@ -421,6 +493,10 @@ void Score::endCmd(bool rollback, bool layoutAllParts)
     const bool noUndo = undoStack()->current()->empty(); // nothing to undo?
     undoStack()->endMacro(noUndo);
 
+    if (!rollback && !noUndo) {
+        updateRevisions(masterScore(), undoStack()->last());
+    }
+
     if (dirty()) {
         masterScore()->setPlaylistDirty(); // TODO: flag individual operations
     }
@@ -3107,13 +3183,15 @@ EngravingItem* Score::selectMove(const String& cmd)
     } else if (cmd == u"select-prev-measure") {
         el = prevMeasure(cr, true);
     } else if (cmd == u"select-begin-line") {
-        Measure* measure = cr->segment()->measure()->system()->firstMeasure();
+        const System* system = cr->segment()->measure()->system();
+        Measure* measure = system ? system->firstMeasure() : nullptr;
         if (!measure) {
             return 0;
         }
         el = measure->first()->nextChordRest(cr->track());
     } else if (cmd == u"select-end-line") {
-        Measure* measure = cr->segment()->measure()->system()->lastMeasure();
+        const System* system = cr->segment()->measure()->system();
+        Measure* measure = system ? system->lastMeasure() : nullptr;
         if (!measure) {
             return 0;
         }
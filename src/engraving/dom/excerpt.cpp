@@ -138,6 +138,10 @@ void Excerpt::setName(const String& name, bool saveAndNotify)
 
     m_name = name;
 
+    if (m_excerptScore) {
+        m_excerptScore->updateRevision();
+    }
+
     if (saveAndNotify) {
         writeNameToMetaTags();
         m_nameChanged.notify();
@@ -249,11 +253,13 @@ void Excerpt::setTracksMapping(const TracksMap& tracksMapping)
 
     m_tracksMapping = tracksMapping;
 
-    const Score* score = excerptScore();
+    Score* score = excerptScore();
     if (!score) {
         return;
     }
 
+    score->updateRevision();
+
     for (Staff* staff : score->staves()) {
         const Staff* masterStaff = m_masterScore->staffById(staff->id());
         if (!masterStaff) {
@@ -87,6 +87,8 @@ bool ImageStoreItem::isUsed(Score* score) const
 
 void ImageStoreItem::load()
 {
+    materialize();
+
     if (!m_buffer.empty()) {
         return;
     }
@@ -101,6 +103,34 @@ void ImageStoreItem::load()
     m_hash = cryptographicHash()->hash(m_buffer, ICryptographicHash::Algorithm::Md4);
 }
 
+//---------------------------------------------------------
+//   doMaterialize
+//---------------------------------------------------------
+
+void ImageStoreItem::doMaterialize() const
+{
+    TRACEFUNC;
+
+    std::lock_guard<std::mutex> lock(m_loaderMutex);
+    if (!m_pending) {
+        return;
+    }
+
+    Loader loader = std::move(m_loader);
+    m_loader = nullptr;
+
+    m_buffer = loader();
+
+    // as for an image read eagerly, the item is identified by its data rather than by its name
+    ByteArray hash = cryptographicHash()->hash(m_buffer, ICryptographicHash::Algorithm::Md4);
+    if (hash != m_hash) {
+        LOGW() << "image data does not match its name: " << m_path;
+        m_hash = hash;
+    }
+
+    m_pending.store(false, std::memory_order_release);
+}
+
 //---------------------------------------------------------
 //   hashName
 //---------------------------------------------------------
@@ -154,8 +184,8 @@ ImageStore::~ImageStore()
 
 ImageStoreItem* ImageStore::getImage(const path_t& path) const
 {
-    String s = FileInfo(path).completeBaseName();
-    if (s.size() != 32) {
+    ByteArray hash = hashFromName(path);
+    if (hash.empty()) {
         //
         // some limited support for backward compatibility
         //
@@ -166,10 +196,6 @@ ImageStoreItem* ImageStore::getImage(const path_t& path) const
         }
         return nullptr;
     }
-    ByteArray hash(16);
-    for (int i = 0; i < 16; ++i) {
-        hash[i] = toInt(s.at(i * 2).toAscii()) * 16 + toInt(s.at(i * 2 + 1).toAscii());
-    }
     for (ImageStoreItem* item : m_items) {
         if (item->hash() == hash) {
             return item;
@@ -197,6 +223,53 @@ ImageStoreItem* ImageStore::add(const path_t& path, const ByteArray& ba)
     return item;
 }
 
+//---------------------------------------------------------
+//   addLazy
+//    the image is identified by the md4 hash in its name,
+//    the data is read by the loader on first use
+//---------------------------------------------------------
+
+ImageStoreItem* ImageStore::addLazy(const path_t& path, const ImageStoreItem::Loader& loader)
+{
+    ByteArray hash = hashFromName(path);
+    if (hash.empty()) {
+        return add(path, loader());
+    }
+    for (ImageStoreItem* item : m_items) {
+        if (item->hash() == hash) {
+            return item;
+        }
+    }
+    ImageStoreItem* item = new ImageStoreItem(path);
+    item->setLoader(hash, loader);
+    m_items.push_back(item);
+    return item;
+}
+
+//---------------------------------------------------------
+//   hashFromName
+//    returns an empty array if the name is not a hash
+//---------------------------------------------------------
+
+ByteArray ImageStore::hashFromName(const path_t& path)
+{
+    String s = FileInfo(path).completeBaseName();
+    if (s.size() != 32) {
+        return ByteArray();
+    }
+    for (size_t i = 0; i < s.size(); ++i) {
+        const char c = s.at(i).toAscii();
+        if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'))) {
+            return ByteArray();
+        }
+    }
+    ByteArray hash(16);
+    for (int i = 0; i < 16; ++i) {
+        hash[i] = toInt(s.at(i * 2).toAscii()) * 16 + toInt(s.at(i * 2 + 1).toAscii());
+    }
+    return hash;
+}
+
 //---------------------------------------------------------
 //   clearUnused
 //---------------------------------------------------------
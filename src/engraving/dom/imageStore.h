@@ -23,7 +23,10 @@
 #ifndef MU_ENGRAVING_IMAGE_CACHE_H
 #define MU_ENGRAVING_IMAGE_CACHE_H
 
+#include <atomic>
+#include <functional>
 #include <list>
+#include <mutex>
 
 #include "types/string.h"
 #include "types/bytearray.h"
@@ -50,9 +53,9 @@ public:
     void reference(Image*);
 
     const muse::io::path_t& path() const { return m_path; }
-    muse::ByteArray& buffer() { return m_buffer; }
-    const muse::ByteArray& buffer() const { return m_buffer; }
-    bool loaded() const { return !m_buffer.empty(); }
+    muse::ByteArray& buffer() { materialize(); return m_buffer; }
+    const muse::ByteArray& buffer() const { materialize(); return m_buffer; }
+    bool loaded() const { return !m_buffer.empty() || m_pending; }
     void setPath(const muse::io::path_t& val);
     bool isUsed(Score*) const;
     bool isUsed() const { return !m_references.empty(); }
@@ -61,13 +64,24 @@ public:
     const muse::ByteArray& hash() const { return m_hash; }
     void set(const muse::ByteArray& b, const muse::ByteArray& h) { m_buffer = b; m_hash = h; }
 
+    //! NOTE The data of a lazily loaded item is uncompressed on the first access to the buffer,
+    //! which may be from a thread rendering the score in the background
+    using Loader = std::function<muse::ByteArray()>;
+    void setLoader(const muse::ByteArray& h, const Loader& loader) { m_hash = h; m_loader = loader; m_pending = true; }
+
 private:
 
+    void materialize() const { if (m_pending.load(std::memory_order_acquire)) { doMaterialize(); } }
+    void doMaterialize() const;
+
     std::list<Image*> m_references;
     muse::io::path_t m_path;                  // original location of image
     muse::String m_type;                      // image type (file extension)
-    muse::ByteArray m_buffer;
-    muse::ByteArray m_hash;               // 16 byte md4 hash of _buffer
+    mutable muse::ByteArray m_buffer;
+    mutable muse::ByteArray m_hash;       // 16 byte md4 hash of _buffer
+    mutable Loader m_loader;
+    mutable std::atomic<bool> m_pending = false;
+    mutable std::mutex m_loaderMutex;
 };
 
 //---------------------------------------------------------
@@ -86,6 +100,7 @@ public:
 
     ImageStoreItem* getImage(const muse::io::path_t& path) const;
     ImageStoreItem* add(const muse::io::path_t& path, const muse::ByteArray&);
+    ImageStoreItem* addLazy(const muse::io::path_t& path, const ImageStoreItem::Loader& loader);
     void clearUnused();
 
     typedef std::vector<ImageStoreItem*> ItemList;
@@ -97,6 +112,8 @@ public:
     iterator end() { return m_items.end(); }
     const_iterator end() const { return m_items.end(); }
 
+    static muse::ByteArray hashFromName(const muse::io::path_t& path);
+
 private:
 
     ItemList m_items;
@@ -2828,6 +2828,20 @@ Measure* Measure::mmRestLast() const
     return score()->lastMeasure();
 }
 
+//---------------------------------------------------------
+//   setMMRest
+//---------------------------------------------------------
+
+void Measure::setMMRest(Measure* m)
+{
+    if (m_mmRest == m) {
+        return;
+    }
+
+    m_mmRest = m;
+    score()->measures()->invalidateTickIndexMM();
+}
+
 //---------------------------------------------------------
 //   coveringMMRestOrThis
 //    if multi-measure rests are enabled,
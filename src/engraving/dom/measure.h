@@ -311,7 +311,7 @@ public:
     bool isMMRest() const { return m_mmRestCount > 0; }
     Measure* mmRest() const { return m_mmRest; }
     const Measure* coveringMMRestOrThis() const;
-    void setMMRest(Measure* m) { m_mmRest = m; }
+    void setMMRest(Measure* m);
     int mmRestCount() const { return m_mmRestCount; }            // number of measures m_mmRest spans
     void setMMRestCount(int n) { m_mmRestCount = n; }
     Measure* mmRestFirst() const;
@@ -361,6 +361,19 @@ public:
 
     bool canAddStringTunings(staff_idx_t staffIdx) const;
 
+    struct LayoutData : public EngravingItem::LayoutData {
+        // fingerprint of the layout input of the measure at its last full layout,
+        // zero means that the measure was not laid out since the last reset
+        uint64_t contentHash = 0;
+
+        void reset() override
+        {
+            EngravingItem::LayoutData::reset();
+            contentHash = 0;
+        }
+    };
+    DECLARE_LAYOUTDATA_METHODS(Measure)
+
 private:
 
     friend class Factory;
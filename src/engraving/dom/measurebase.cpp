@@ -342,7 +342,15 @@ Fraction MeasureBase::tick() const
 
 void MeasureBase::setTick(const Fraction& f)
 {
+    if (m_tick == f) {
+        return;
+    }
+
     m_tick = f;
+
+    if (Score* s = score()) {
+        s->measures()->invalidateTickIndex(this);
+    }
 }
 
 //---------------------------------------------------------
@@ -682,6 +690,17 @@ MeasureBaseList::MeasureBaseList()
     m_size  = 0;
 }
 
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void MeasureBaseList::clear()
+{
+    m_first = m_last = 0;
+    m_size = 0;
+    invalidateTickIndex(nullptr);
+}
+
 //---------------------------------------------------------
 //   push_back
 //---------------------------------------------------------
@@ -699,6 +718,7 @@ void MeasureBaseList::push_back(MeasureBase* e)
         e->setNext(0);
     }
     m_last = e;
+    invalidateTickIndex(e);
 }
 
 //---------------------------------------------------------
@@ -718,6 +738,7 @@ void MeasureBaseList::push_front(MeasureBase* e)
         e->setNext(0);
     }
     m_first = e;
+    invalidateTickIndex(nullptr);
 }
 
 //---------------------------------------------------------
@@ -740,6 +761,7 @@ void MeasureBaseList::add(MeasureBase* e)
     e->setPrev(el->prev());
     el->prev()->setNext(e);
     el->setPrev(e);
+    invalidateTickIndex(e);
 }
 
 //---------------------------------------------------------
@@ -749,6 +771,7 @@ void MeasureBaseList::add(MeasureBase* e)
 void MeasureBaseList::remove(MeasureBase* el)
 {
     --m_size;
+    invalidateTickIndex(el->prev());
     if (el->prev()) {
         el->prev()->setNext(el->next());
     } else {
@@ -783,6 +806,7 @@ void MeasureBaseList::insert(MeasureBase* fm, MeasureBase* lm)
     } else {
         m_last = lm;
     }
+    invalidateTickIndex(pm);
 }
 
 //---------------------------------------------------------
@@ -797,6 +821,7 @@ void MeasureBaseList::remove(MeasureBase* fm, MeasureBase* lm)
     }
     MeasureBase* pm = fm->prev();
     MeasureBase* nm = lm->next();
+    invalidateTickIndex(pm);
     if (pm) {
         pm->setNext(nm);
     } else {
@@ -815,6 +840,7 @@ void MeasureBaseList::remove(MeasureBase* fm, MeasureBase* lm)
 
 void MeasureBaseList::change(MeasureBase* ob, MeasureBase* nb)
 {
+    invalidateTickIndex(ob->prev());
     nb->setPrev(ob->prev());
     nb->setNext(ob->next());
     if (ob->prev()) {
@@ -837,3 +863,168 @@ void MeasureBaseList::change(MeasureBase* ob, MeasureBase* nb)
         e->setParent(nb);
     }
 }
+
+//---------------------------------------------------------
+//   invalidateTickIndex
+//    mb changed its tick or its place in the list,
+//    nullptr means the beginning of the list
+//---------------------------------------------------------
+
+void MeasureBaseList::invalidateTickIndex(const MeasureBase* mb)
+{
+    invalidateTickIndexMM();
+
+    if (!mb) {
+        m_tickIndexDirtyFrom = 0;
+        m_tickIndexValid.store(false, std::memory_order_release);
+        return;
+    }
+
+    // not (yet) in the list
+    if (mb != m_first && !mb->prev() && !mb->next()) {
+        return;
+    }
+
+    m_tickIndexValid.store(false, std::memory_order_release);
+
+    // the index is still valid up to the nearest indexed measure before mb
+    for (const MeasureBase* p = mb; p; p = p->prev()) {
+        const size_t pos = p->m_tickIndexPos;
+        if (pos < m_tickIndex.entries.size() && m_tickIndex.entries.at(pos).measure == p) {
+            m_tickIndexDirtyFrom = std::min(m_tickIndexDirtyFrom, pos);
+            return;
+        }
+    }
+
+    m_tickIndexDirtyFrom = 0;
+}
+
+void MeasureBaseList::invalidateTickIndexMM()
+{
+    m_tickIndexMMValid[0].store(false, std::memory_order_release);
+    m_tickIndexMMValid[1].store(false, std::memory_order_release);
+}
+
+//---------------------------------------------------------
+//   measureAtTick
+//---------------------------------------------------------
+
+Measure* MeasureBaseList::measureAtTick(const Fraction& tick) const
+{
+    if (!m_tickIndexValid.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(m_tickIndexMutex);
+        // another thread may have rebuilt it in the meantime
+        if (!m_tickIndexValid.load(std::memory_order_relaxed)) {
+            updateTickIndex();
+            m_tickIndexValid.store(true, std::memory_order_release);
+        }
+    }
+    return m_tickIndex.find(tick);
+}
+
+Measure* MeasureBaseList::measureAtTickMM(const Fraction& tick, bool createMMRests) const
+{
+    const size_t idx = createMMRests ? 1 : 0;
+    if (!m_tickIndexMMValid[idx].load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(m_tickIndexMutex);
+        if (!m_tickIndexMMValid[idx].load(std::memory_order_relaxed)) {
+            updateTickIndexMM(createMMRests);
+            m_tickIndexMMValid[idx].store(true, std::memory_order_release);
+        }
+    }
+    return m_tickIndexMM[idx].find(tick);
+}
+
+void MeasureBaseList::updateTickIndex() const
+{
+    m_tickIndex.truncate(m_tickIndexDirtyFrom);
+
+    Measure* m = nullptr;
+    if (m_tickIndex.entries.empty()) {
+        MeasureBase* mb = m_first;
+        while (mb && !mb->isMeasure()) {
+            mb = mb->next();
+        }
+        m = toMeasure(mb);
+    } else {
+        m = m_tickIndex.entries.back().measure->nextMeasure();
+    }
+
+    for (; m; m = m->nextMeasure()) {
+        static_cast<MeasureBase*>(m)->m_tickIndexPos = m_tickIndex.entries.size();
+        m_tickIndex.append(m);
+    }
+
+    m_tickIndexDirtyFrom = muse::nidx;
+}
+
+void MeasureBaseList::updateTickIndexMM(bool createMMRests) const
+{
+    TickIndex& index = m_tickIndexMM[createMMRests ? 1 : 0];
+    index.truncate(0);
+
+    MeasureBase* mb = m_first;
+    while (mb && !mb->isMeasure()) {
+        mb = mb->next();
+    }
+
+    // the same walk as Score::firstMeasureMM() / MeasureBase::nextMeasureMM()
+    Measure* m = toMeasure(mb);
+    if (m && createMMRests && m->hasMMRest()) {
+        m = m->mmRest();
+    }
+
+    for (; m; m = m->nextMeasureMM()) {
+        index.append(m);
+    }
+}
+
+//---------------------------------------------------------
+//   TickIndex
+//---------------------------------------------------------
+
+void MeasureBaseList::TickIndex::truncate(size_t size)
+{
+    if (size < entries.size()) {
+        entries.resize(size);
+    }
+    if (unsortedFrom >= entries.size()) {
+        unsortedFrom = muse::nidx;
+    }
+}
+
+void MeasureBaseList::TickIndex::append(Measure* m)
+{
+    Entry e;
+    e.tick = m->tick();
+    e.measure = m;
+
+    if (unsortedFrom == muse::nidx && !entries.empty() && e.tick < entries.back().tick) {
+        unsortedFrom = entries.size();
+    }
+
+    entries.push_back(e);
+}
+
+//---------------------------------------------------------
+//   TickIndex::find
+//    the entry before the first one starting after tick,
+//    which is the last entry if there is none
+//---------------------------------------------------------
+
+Measure* MeasureBaseList::TickIndex::find(const Fraction& tick) const
+{
+    auto startsAfter = [](const Fraction& t, const Entry& e) { return t < e.tick; };
+
+    const size_t sortedSize = std::min(unsortedFrom, entries.size());
+    auto it = std::upper_bound(entries.begin(), entries.begin() + sortedSize, tick, startsAfter);
+
+    // while ticks are out of order, keep the semantics of walking the list
+    if (it == entries.begin() + sortedSize) {
+        while (it != entries.end() && !startsAfter(tick, *it)) {
+            ++it;
+        }
+    }
+
+    return it == entries.begin() ? nullptr : std::prev(it)->measure;
+}
@@ -28,6 +28,10 @@
  Definition of MeasureBase class.
 */
 
+#include <atomic>
+#include <mutex>
+#include <vector>
+
 #include "engravingitem.h"
 
 namespace mu::engraving {
@@ -189,6 +193,8 @@ protected:
     Fraction m_len  { Fraction(0, 1) };    // actual length of measure
 
 private:
+    friend class MeasureBaseList;
+
     MeasureBase* m_next = nullptr;
     MeasureBase* m_prev = nullptr;
 
@@ -198,6 +204,7 @@ private:
     int m_no = 0;                         // Measure number, counting from zero
     int m_noOffset = 0;                   // Offset to measure number
     double m_oldWidth = 0.0;              // Used to restore layout during recalculations in Score::collectSystem()
+    mutable size_t m_tickIndexPos = muse::nidx;  // position in the MeasureBaseList tick index, if any
 };
 
 //---------------------------------------------------------
@@ -210,7 +217,7 @@ public:
     MeasureBaseList();
     MeasureBase* first() const { return m_first; }
     MeasureBase* last()  const { return m_last; }
-    void clear() { m_first = m_last = 0; m_size = 0; }
+    void clear();
     void add(MeasureBase*);
     void remove(MeasureBase*);
     void insert(MeasureBase*, MeasureBase*);
@@ -219,13 +226,49 @@ public:
     int size() const { return m_size; }
     bool empty() const { return m_size == 0; }
 
+    // Tick index: the measures in tick order, rebuilt lazily from the first changed measure.
+    // Returns the last measure starting at or before tick (nullptr if none).
+    // The lookups may run on several threads at once, the invalidation only on the thread
+    // that changes the score, while no lookups run.
+    Measure* measureAtTick(const Fraction& tick) const;
+    Measure* measureAtTickMM(const Fraction& tick, bool createMMRests) const;
+    void invalidateTickIndex(const MeasureBase* mb);
+    void invalidateTickIndexMM();
+
 private:
     void push_back(MeasureBase* e);
     void push_front(MeasureBase* e);
 
+    struct TickIndex {
+        struct Entry {
+            Fraction tick;
+            Measure* measure = nullptr;
+        };
+
+        std::vector<Entry> entries;
+        size_t unsortedFrom = muse::nidx;   // first entry starting before the previous one, while ticks are being fixed
+
+        void truncate(size_t size);
+        void append(Measure* m);
+        Measure* find(const Fraction& tick) const;
+    };
+
+    void updateTickIndex() const;
+    void updateTickIndexMM(bool createMMRests) const;
+
     int m_size = 0;
     MeasureBase* m_first = nullptr;
     MeasureBase* m_last = nullptr;
+
+    // only taken to rebuild an invalid index, concurrent lookups of a valid index don't lock
+    mutable std::mutex m_tickIndexMutex;
+    mutable TickIndex m_tickIndex;
+    mutable std::atomic<bool> m_tickIndexValid = false;
+    mutable size_t m_tickIndexDirtyFrom = 0;
+
+    // one for each setting of createMultiMeasureRests
+    mutable TickIndex m_tickIndexMM[2];
+    mutable std::atomic<bool> m_tickIndexMMValid[2] = { false, false };
 };
 } // namespace mu::engraving
 #endif
@@ -66,6 +66,7 @@ int MScore::defaultPlayDuration;
 
 bool MScore::noExcerpts = false;
 bool MScore::noImages = false;
+bool MScore::lazyLoadImages = false;
 bool MScore::pdfPrinting = false;
 bool MScore::svgPrinting = false;
 
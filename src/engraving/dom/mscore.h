@@ -232,6 +232,7 @@ public:
 
     static bool noExcerpts;
     static bool noImages;
+    static bool lazyLoadImages;         // read the images of a mscz file on first use
 
     static bool pdfPrinting;
     static bool svgPrinting;
@@ -81,6 +81,10 @@ public:
     RectF tbbox() const;                             // tight bounding box, excluding white space
     Fraction endTick() const;
 
+    // kept from the previous layout, the layout was stopped before this page
+    bool isProvisional() const { return m_provisional; }
+    void setProvisional(bool v) { m_provisional = v; }
+
 #ifndef ENGRAVING_NO_ACCESSIBILITY
     AccessibleItemPtr createAccessible() override;
 #endif
@@ -97,6 +101,7 @@ private:
 
     std::vector<System*> m_systems;
     page_idx_t m_no = 0;                        // page number
+    bool m_provisional = false;
 
     BspTree bspTree;
     bool m_bspTreeValid = false;
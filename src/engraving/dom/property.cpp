@@ -22,6 +22,9 @@
 
 #include "property.h"
 
+#include <string_view>
+#include <unordered_map>
+
 #include "translation.h"
 
 #include "types/typesconv.h"
@@ -44,7 +47,7 @@ namespace mu::engraving {
 struct PropertyMetaData {
     Pid id;                   // associated Pid
     bool link;                // link this property for linked elements
-    const char* name;         // xml name of property
+    AsciiStringView name;     // xml name of property
     P_TYPE type;              // associated P_TYPE
     PropertyGroup group;
     const char* userName;     // user-visible name of property
@@ -454,12 +457,18 @@ static constexpr PropertyMetaData propertyList[] = {
 
 Pid propertyId(const AsciiStringView& s)
 {
-    for (const PropertyMetaData& pd : propertyList) {
-        if (s == pd.name) {
-            return pd.id;
+    //! NOTE The tags are looked up while reading every element, so they are indexed once
+    static const std::unordered_map<std::string_view, Pid> index = []() {
+        std::unordered_map<std::string_view, Pid> idx;
+        idx.reserve(std::size(propertyList));
+        for (const PropertyMetaData& pd : propertyList) {
+            idx.emplace(pd.name, pd.id); // the first one wins, as before
         }
-    }
-    return Pid::END;
+        return idx;
+    }();
+
+    auto it = index.find(s);
+    return it != index.end() ? it->second : Pid::END;
 }
 
 //---------------------------------------------------------
@@ -493,6 +502,18 @@ bool propertyLink(Pid id)
 //---------------------------------------------------------
 
 const char* propertyName(Pid id)
+{
+    assert(propertyList[int(id)].id == id);
+    return propertyList[int(id)].name.ascii();
+}
+
+//---------------------------------------------------------
+//   propertyNameView
+//    the same as propertyName, but with the known size,
+//    to compare with the tags
+//---------------------------------------------------------
+
+const AsciiStringView& propertyNameView(Pid id)
 {
     assert(propertyList[int(id)].id == id);
     return propertyList[int(id)].name;
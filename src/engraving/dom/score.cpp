@@ -27,6 +27,7 @@
 
 #include "score.h"
 
+#include <atomic>
 #include <cmath>
 #include <map>
 
@@ -173,6 +174,8 @@ Score::Score(const modularity::ContextPtr& iocCtx)
 
     m_shadowNote = new ShadowNote(this);
     m_shadowNote->setVisible(false);
+
+    updateRevision();
 }
 
 Score::Score(MasterScore* parent, bool forcePartStyle /* = true */)
@@ -799,7 +802,22 @@ bool Score::isOpen() const
 
 void Score::setIsOpen(bool open)
 {
+    if (m_isOpen == open) {
+        return;
+    }
+
     m_isOpen = open;
+    updateRevision();
+}
+
+//---------------------------------------------------------
+//   updateRevision
+//---------------------------------------------------------
+
+void Score::updateRevision()
+{
+    static std::atomic<uint64_t> lastRevision = 0;
+    m_revision = ++lastRevision;
 }
 
 //---------------------------------------------------------
@@ -2039,6 +2057,7 @@ String Score::metaTag(const String& s) const
 void Score::setMetaTag(const String& tag, const String& val)
 {
     m_metaTags.insert_or_assign(tag, val);
+    updateRevision();
 }
 
 //---------------------------------------------------------
@@ -5402,6 +5421,8 @@ void Score::resetStyleValues(const StyleIdSet& styleIdSet)
 
 void Score::setStyle(const MStyle& s, const bool overlap)
 {
+    updateRevision();
+
     if (!overlap) {
         style() = s;
         return;
@@ -5718,6 +5739,92 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
     }
 }
 
+//---------------------------------------------------------
+//   hasProvisionalPages
+//    the provisional pages are always at the end of the score
+//---------------------------------------------------------
+
+bool Score::hasProvisionalPages() const
+{
+    return !m_pages.empty() && m_pages.back()->isProvisional();
+}
+
+//---------------------------------------------------------
+//   layoutProvisionalPages
+//    continue a lazy layout from the first provisional page,
+//    either for the next few pages or to the end of the score
+//---------------------------------------------------------
+
+void Score::layoutProvisionalPages(bool all)
+{
+    TRACEFUNC;
+
+    const Fraction tick = provisionalPagesTick();
+    doLayoutRange(tick, all ? Fraction(-1, 1) : tick);
+}
+
+//---------------------------------------------------------
+//   layoutProvisionalPagesUpTo
+//    continue a lazy layout at least up to the given tick,
+//    so that the measures there have a system and a page
+//---------------------------------------------------------
+
+void Score::layoutProvisionalPagesUpTo(const Fraction& tick)
+{
+    if (!hasProvisionalPages()) {
+        return;
+    }
+
+    const Fraction startTick = provisionalPagesTick();
+    if (tick < startTick) {
+        return;
+    }
+
+    TRACEFUNC;
+
+    doLayoutRange(startTick, tick);
+}
+
+//---------------------------------------------------------
+//   layoutSelectionIfProvisional
+//    the selection can move beyond the laid out pages,
+//    e.g. by navigation, but it must always be laid out
+//---------------------------------------------------------
+
+void Score::layoutSelectionIfProvisional()
+{
+    if (!hasProvisionalPages() || m_selection.isNone()) {
+        return;
+    }
+
+    Fraction tick = m_selection.isRange() ? m_selection.tickEnd() : Fraction(-1, 1);
+    for (const EngravingItem* e : m_selection.elements()) {
+        tick = std::max(tick, e->tick());
+    }
+
+    layoutProvisionalPagesUpTo(tick);
+}
+
+//---------------------------------------------------------
+//   provisionalPagesTick
+//    the end of the laid out part of a lazy layout
+//---------------------------------------------------------
+
+Fraction Score::provisionalPagesTick() const
+{
+    Fraction tick = Fraction(0, 1);
+    for (const Page* page : m_pages) {
+        if (page->isProvisional()) {
+            break;
+        }
+        if (!page->systems().empty()) {
+            tick = page->systems().back()->endTick();
+        }
+    }
+
+    return tick;
+}
+
 void Score::createPaddingTable()
 {
     m_paddingTable.createTable(style());
@@ -37,6 +37,7 @@
 
 #include "modularity/ioc.h"
 #include "draw/iimageprovider.h"
+#include "draw/types/drawdata.h"
 #include "global/iapplication.h"
 #include "../iengravingfontsprovider.h"
 
@@ -646,6 +647,11 @@ public:
     bool isOpen() const;
     void setIsOpen(bool open);
 
+    //! NOTE Unique across all scores, changes whenever a command touches this score,
+    //! and whenever something that is written to the file is changed outside the undo stack
+    uint64_t revision() const { return m_revision; }
+    void updateRevision();
+
     void spell();
     void spell(staff_idx_t startStaff, staff_idx_t endStaff, Segment* startSegment, Segment* endSegment);
     void spell(Note*);
@@ -822,7 +828,7 @@ public:
 
     const std::map<String, String>& metaTags() const { return m_metaTags; }
     std::map<String, String>& metaTags() { return m_metaTags; }
-    void setMetaTags(const std::map<String, String>& t) { m_metaTags = t; }
+    void setMetaTags(const std::map<String, String>& t) { m_metaTags = t; updateRevision(); }
 
     //@ returns as a string the metatag named 'tag'
     String metaTag(const String& tag) const;
@@ -849,6 +855,13 @@ public:
     const LayoutOptions& layoutOptions() const { return m_layoutOptions; }
     void setLayoutMode(LayoutMode lm) { m_layoutOptions.mode = lm; }
     void setShowVBox(bool v) { m_layoutOptions.isShowVBox = v; }
+    void setParallelLayout(bool v) { m_layoutOptions.isParallelLayout = v; }
+    void setMeasureLayoutCache(bool v) { m_layoutOptions.isMeasureLayoutCache = v; }
+    void setLazyLayoutPages(size_t n) { m_layoutOptions.lazyLayoutPages = n; }
+    bool hasProvisionalPages() const;
+    void layoutProvisionalPages(bool all = false);
+    void layoutProvisionalPagesUpTo(const Fraction& tick);
+    void layoutSelectionIfProvisional();
     double noteHeadWidth() const { return m_layoutOptions.noteHeadWidth; }
     void setNoteHeadWidth(double n) { m_layoutOptions.noteHeadWidth = n; }
 
@@ -959,6 +972,9 @@ public:
     ChordRest* cmdTopStaff(ChordRest* cr = nullptr);
 
     std::shared_ptr<muse::draw::Pixmap> createThumbnail();
+    muse::draw::DrawDataPtr paintThumbnail();
+    static std::shared_ptr<muse::draw::Pixmap> renderThumbnail(const muse::draw::DrawDataPtr& data,
+                                                               muse::draw::IImageProvider* provider);
     String createRehearsalMarkText(RehearsalMark* current) const;
     String nextRehearsalMarkText(RehearsalMark* previous, RehearsalMark* current) const;
 
@@ -1026,6 +1042,7 @@ private:
     static std::set<Score*> validScores;
 
     ScoreChangesRange changesRange() const;
+    Fraction provisionalPagesTick() const;
 
     Note* getSelectedNote();
     ChordRest* nextTrack(ChordRest* cr, bool skipMeasureRepeatRests = true);
@@ -1145,6 +1162,8 @@ private:
     double m_minimumPaddingUnit = 0.0;
 
     bool m_updatesLocked = false;
+
+    uint64_t m_revision = 0;
 };
 
 static inline Score* toScore(EngravingObject* e)
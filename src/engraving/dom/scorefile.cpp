@@ -25,6 +25,9 @@
 #include "io/file.h"
 #include "io/fileinfo.h"
 
+#include "draw/bufferedpaintprovider.h"
+#include "draw/utils/drawdatapaint.h"
+
 #include "style/style.h"
 
 #include "engravingitem.h"
@@ -70,6 +73,17 @@ void Score::linkMeasures(Score* score)
 //---------------------------------------------------------
 
 std::shared_ptr<Pixmap> Score::createThumbnail()
+{
+    return renderThumbnail(paintThumbnail(), imageProvider().get());
+}
+
+//---------------------------------------------------------
+//   paintThumbnail
+//    records the painting of the first page, the viewport
+//    of the result is the size of the thumbnail
+//---------------------------------------------------------
+
+DrawDataPtr Score::paintThumbnail()
 {
     TRACEFUNC;
 
@@ -82,20 +96,19 @@ std::shared_ptr<Pixmap> Score::createThumbnail()
     int w = int(fr.width() * mag);
     int h = int(fr.height() * mag);
 
-    int dpm = lrint(DPMM * 1000.0);
-
-    auto pixmap = imageProvider()->createPixmap(w, h, dpm, configuration()->thumbnailBackgroundColor());
-
     double pr = MScore::pixelRatio;
     MScore::pixelRatio = 1.0;
 
-    auto painterProvider = imageProvider()->painterForImage(pixmap);
-    Painter p(painterProvider, "thumbnail");
+    auto buffer = std::make_shared<BufferedPaintProvider>();
+    {
+        Painter p(buffer, "thumbnail");
 
-    p.setAntialiasing(true);
-    p.scale(mag, mag);
-    print(&p, 0);
-    p.endDraw();
+        p.fillRect(RectF(0, 0, w, h), configuration()->thumbnailBackgroundColor());
+        p.setAntialiasing(true);
+        p.scale(mag, mag);
+        print(&p, 0);
+        p.endDraw();
+    }
 
     MScore::pixelRatio = pr;
 
@@ -103,6 +116,30 @@ std::shared_ptr<Pixmap> Score::createThumbnail()
         setLayoutMode(mode);
         doLayout();
     }
+
+    DrawDataPtr data = buffer->drawData();
+    data->viewport = RectF(0, 0, w, h);
+    return data;
+}
+
+//---------------------------------------------------------
+//   renderThumbnail
+//    touches neither a score nor the ioc context,
+//    so it can run on any thread
+//---------------------------------------------------------
+
+std::shared_ptr<Pixmap> Score::renderThumbnail(const DrawDataPtr& data, IImageProvider* provider)
+{
+    TRACEFUNC;
+
+    int dpm = lrint(DPMM * 1000.0);
+
+    auto pixmap = provider->createPixmap(int(data->viewport.width()), int(data->viewport.height()), dpm, Color::transparent);
+
+    Painter p(provider->painterForImage(pixmap), "thumbnail");
+    DrawDataPaint::paint(&p, data);
+    p.endDraw();
+
     return pixmap;
 }
 
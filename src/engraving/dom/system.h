@@ -120,6 +120,10 @@ public:
 
     void clear(); ///< Clear measure list.
 
+    // a placeholder for the measures a lazy layout has not reached yet, it is on no page's system list
+    bool isProvisional() const { return m_provisional; }
+    void setProvisional(bool v) { m_provisional = v; }
+
     std::vector<SysStaff*>& staves() { return m_staves; }
     const std::vector<SysStaff*>& staves() const { return m_staves; }
     double staffYpage(staff_idx_t staffIdx) const;
@@ -227,6 +231,7 @@ private:
     mutable bool m_fixedDownDistance = false;
     double m_distance = 0.0;        // temp. variable used during layout
     double m_systemHeight = 0.0;
+    bool m_provisional = false;
 };
 
 typedef std::vector<System*>::iterator iSystem;
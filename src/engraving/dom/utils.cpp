@@ -71,13 +71,10 @@ Measure* Score::tick2measure(const Fraction& tick) const
         return firstMeasure();
     }
 
-    Measure* lm = 0;
-    for (Measure* m = firstMeasure(); m; m = m->nextMeasure()) {
-        if (tick < m->tick()) {
-            assert(lm);
-            return lm;
-        }
-        lm = m;
+    Measure* lm = m_measures.measureAtTick(tick);
+    assert(lm || !firstMeasure());
+    if (lm && lm->nextMeasure()) {
+        return lm;
     }
     // check last measure
     if (lm && (tick >= lm->tick()) && (tick <= lm->endTick())) {
@@ -101,14 +98,10 @@ Measure* Score::tick2measureMM(const Fraction& t) const
         tick = Fraction(0, 1);
     }
 
-    Measure* lm = 0;
-
-    for (Measure* m = firstMeasureMM(); m; m = m->nextMeasureMM()) {
-        if (tick < m->tick()) {
-            assert(lm);
-            return lm;
-        }
-        lm = m;
+    Measure* lm = m_measures.measureAtTickMM(tick, style().styleB(Sid::createMultiMeasureRests));
+    assert(lm || !firstMeasureMM());
+    if (lm && lm->nextMeasureMM()) {
+        return lm;
     }
     // check last measure
     if (lm && (tick >= lm->tick()) && (tick <= lm->endTick())) {
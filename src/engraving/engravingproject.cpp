@@ -148,12 +148,13 @@ Ret EngravingProject::loadMscz(const MscReader& msc, SettingsCompat& settingsCom
     return loader.loadMscz(m_masterScore, msc, settingsCompat, ignoreVersionError);
 }
 
-bool EngravingProject::writeMscz(MscWriter& writer, bool onlySelection, bool createThumbnail)
+bool EngravingProject::writeMscz(MscWriter& writer, bool onlySelection, bool createThumbnail, bool reuseUnchangedExcerpts)
 {
     TRACEFUNC;
 
     MscSaver saver(iocContext());
-    return saver.writeMscz(m_masterScore, writer, onlySelection, createThumbnail);
+    return saver.writeMscz(m_masterScore, writer, onlySelection, createThumbnail,
+                           reuseUnchangedExcerpts ? &m_excerptsCache : nullptr);
 }
 
 bool EngravingProject::isCorruptedUponLoading() const
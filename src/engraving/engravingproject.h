@@ -28,6 +28,7 @@
 #include "infrastructure/mscreader.h"
 #include "infrastructure/mscwriter.h"
 #include "infrastructure/ifileinfoprovider.h"
+#include "rw/mscsaver.h"
 #include "types/types.h"
 
 #include "modularity/ioc.h"
@@ -70,7 +71,9 @@ public:
     muse::Ret setupMasterScore(bool forceMode);
 
     muse::Ret loadMscz(const MscReader& msc, SettingsCompat& settingsCompat, bool ignoreVersionError);
-    bool writeMscz(MscWriter& writer, bool onlySelection, bool createThumbnail);
+    //! NOTE With reuseUnchangedExcerpts, the excerpts that haven't changed since the previous such write
+    //! are not serialized again (meant for autosave)
+    bool writeMscz(MscWriter& writer, bool onlySelection, bool createThumbnail, bool reuseUnchangedExcerpts = false);
 
     bool isCorruptedUponLoading() const;
     muse::Ret checkCorrupted() const;
@@ -85,6 +88,7 @@ private:
     muse::Ret doSetupMasterScore(bool forceMode);
 
     MasterScore* m_masterScore = nullptr;
+    MscSaver::ExcerptsCache m_excerptsCache;
 
     bool m_isCorruptedUponLoading = false;
 };
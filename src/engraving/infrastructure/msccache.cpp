@@ -0,0 +1,256 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "msccache.h"
+
+#include <cstring>
+#include <random>
+
+#include "io/file.h"
+#include "io/mappedfile.h"
+#include "engraving/engravingerrors.h"
+
+#include "log.h"
+
+using namespace muse;
+using namespace muse::io;
+using namespace mu::engraving;
+
+//! NOTE Layout of the cache file, in the byte order of the machine that wrote it:
+//!   magic, format version, source size, source hash, file size, entry count,
+//!   entries (name size, name, offset, size), data of the entries
+static const char MAGIC[8] = { 'M', 'S', 'C', 'C', 'A', 'C', 'H', 'E' };
+static constexpr uint32_t FORMAT_VERSION = 1;
+
+template<typename T>
+static void writeValue(ByteArray& out, T val)
+{
+    out.push_back(reinterpret_cast<const uint8_t*>(&val), sizeof(T));
+}
+
+template<typename T>
+static bool readValue(const uint8_t*& p, const uint8_t* end, T& val)
+{
+    if (static_cast<size_t>(end - p) < sizeof(T)) {
+        return false;
+    }
+
+    std::memcpy(&val, p, sizeof(T));
+    p += sizeof(T);
+    return true;
+}
+
+MscCache::MscCache()
+{
+}
+
+MscCache::~MscCache()
+{
+    close();
+}
+
+path_t MscCache::cachePath(const path_t& filePath)
+{
+    return filePath.appendingSuffix("cache");
+}
+
+uint64_t MscCache::hash(const ByteArray& data)
+{
+    // FNV-1a
+    uint64_t h = 14695981039346656037ull;
+    const uint8_t* p = data.constData();
+    const uint8_t* end = p + data.size();
+    for (; p != end; ++p) {
+        h ^= *p;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+Ret MscCache::write(const path_t& cachePath, const ByteArray& sourceData,
+                    const std::vector<std::pair<String, ByteArray> >& files)
+{
+    TRACEFUNC;
+
+    std::vector<ByteArray> names;
+    size_t headerSize = sizeof(MAGIC) + sizeof(uint32_t) + 3 * sizeof(uint64_t) + sizeof(uint32_t);
+    for (const auto& file : files) {
+        names.push_back(file.first.toUtf8());
+        headerSize += sizeof(uint32_t) + names.back().size() + 2 * sizeof(uint64_t);
+    }
+
+    size_t totalSize = headerSize;
+    for (const auto& file : files) {
+        totalSize += file.second.size();
+    }
+
+    ByteArray out;
+    out.reserve(totalSize);
+
+    out.push_back(reinterpret_cast<const uint8_t*>(MAGIC), sizeof(MAGIC));
+    writeValue<uint32_t>(out, FORMAT_VERSION);
+    writeValue<uint64_t>(out, sourceData.size());
+    writeValue<uint64_t>(out, hash(sourceData));
+    writeValue<uint64_t>(out, totalSize);
+    writeValue<uint32_t>(out, static_cast<uint32_t>(files.size()));
+
+    size_t offset = headerSize;
+    for (size_t i = 0; i < files.size(); ++i) {
+        writeValue<uint32_t>(out, static_cast<uint32_t>(names.at(i).size()));
+        out.push_back(names.at(i));
+        writeValue<uint64_t>(out, offset);
+        writeValue<uint64_t>(out, files.at(i).second.size());
+        offset += files.at(i).second.size();
+    }
+
+    for (const auto& file : files) {
+        out.push_back(file.second);
+    }
+
+    DO_ASSERT(out.size() == totalSize);
+
+    //! NOTE Other instances may have the cache mapped, rewriting it in place would truncate their mapping.
+    //! So it is written to a new file next to it, which then replaces it.
+    const path_t tempPath = cachePath.appendingSuffix(std::to_string(std::random_device()()) + ".tmp");
+
+    Ret ret = File::writeFile(tempPath, out);
+    if (!ret) {
+        File::remove(tempPath);
+        return ret;
+    }
+
+    //! NOTE The old cache is removed first, other instances that have it mapped keep the removed file.
+    //! On Windows a mapped file can't be removed, then the old cache stays and the new one is dropped.
+    ret = fileSystem()->move(tempPath, cachePath, /*replace*/ true);
+    if (!ret) {
+        LOGW() << "failed to replace cache: " << cachePath;
+        File::remove(tempPath);
+    }
+
+    return ret;
+}
+
+Ret MscCache::open(const path_t& cachePath, const ByteArray& sourceData)
+{
+    TRACEFUNC;
+
+    close();
+
+    if (!File::exists(cachePath)) {
+        return make_ret(Err::FileNotFound, cachePath);
+    }
+
+    std::unique_ptr<MappedFile> file = std::make_unique<MappedFile>(cachePath);
+    if (!file->open(IODevice::ReadOnly)) {
+        return make_ret(Err::FileOpenError, cachePath);
+    }
+
+    const uint8_t* begin = file->readData();
+    const uint8_t* end = begin + file->size();
+    const uint8_t* p = begin;
+
+    auto badFormat = [&cachePath]() {
+        LOGD() << "outdated or damaged cache: " << cachePath;
+        return make_ret(Err::FileBadFormat, cachePath);
+    };
+
+    if (file->size() < sizeof(MAGIC) || std::memcmp(p, MAGIC, sizeof(MAGIC)) != 0) {
+        return badFormat();
+    }
+    p += sizeof(MAGIC);
+
+    uint32_t version = 0;
+    uint64_t sourceSize = 0;
+    uint64_t sourceHash = 0;
+    uint64_t totalSize = 0;
+    uint32_t entryCount = 0;
+    if (!readValue(p, end, version) || version != FORMAT_VERSION
+        || !readValue(p, end, sourceSize) || sourceSize != sourceData.size()
+        || !readValue(p, end, sourceHash) || sourceHash != hash(sourceData)
+        || !readValue(p, end, totalSize) || totalSize != file->size()
+        || !readValue(p, end, entryCount)) {
+        return badFormat();
+    }
+
+    std::map<String, Entry> entries;
+    for (uint32_t i = 0; i < entryCount; ++i) {
+        uint32_t nameSize = 0;
+        if (!readValue(p, end, nameSize) || static_cast<size_t>(end - p) < nameSize) {
+            return badFormat();
+        }
+
+        String name = String::fromUtf8(ByteArray(p, nameSize));
+        p += nameSize;
+
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        if (!readValue(p, end, offset) || !readValue(p, end, size) || offset > totalSize || size > totalSize - offset) {
+            return badFormat();
+        }
+
+        entries[name] = { static_cast<size_t>(offset), static_cast<size_t>(size) };
+    }
+
+    m_file = std::move(file);
+    m_entries = std::move(entries);
+
+    return make_ok();
+}
+
+void MscCache::close()
+{
+    if (m_file) {
+        m_file->close();
+        m_file.reset();
+    }
+
+    m_entries.clear();
+}
+
+bool MscCache::isOpened() const
+{
+    return m_file != nullptr;
+}
+
+StringList MscCache::fileList() const
+{
+    StringList files;
+    for (const auto& entry : m_entries) {
+        files << entry.first;
+    }
+    return files;
+}
+
+bool MscCache::fileExists(const String& fileName) const
+{
+    return m_entries.find(fileName) != m_entries.end();
+}
+
+ByteArray MscCache::fileData(const String& fileName, bool shared) const
+{
+    auto it = m_entries.find(fileName);
+    if (it == m_entries.end() || !m_file) {
+        return ByteArray();
+    }
+
+    m_file->seek(it->second.offset);
+    return shared ? m_file->readShared(it->second.size) : m_file->read(it->second.size);
+}
@@ -0,0 +1,81 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_ENGRAVING_MSCCACHE_H
+#define MU_ENGRAVING_MSCCACHE_H
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "types/bytearray.h"
+#include "types/ret.h"
+#include "types/string.h"
+#include "io/path.h"
+#include "io/ifilesystem.h"
+#include "modularity/ioc.h"
+
+namespace muse::io {
+class MappedFile;
+}
+
+namespace mu::engraving {
+//! NOTE Unpacked copy of the files of a mscz container, stored next to it.
+//! Reading it again needs neither the zip directory nor inflating,
+//! the files are used straight from a memory mapping.
+//! It is keyed by the hash of the container it was made from,
+//! any change of the container makes it invalid.
+//! It only saves the container cost, the score is still parsed from the XML and laid out,
+//! which take most of the time of opening a score.
+class MscCache
+{
+public:
+    MscCache();
+    ~MscCache();
+
+    static muse::io::path_t cachePath(const muse::io::path_t& filePath);
+    static uint64_t hash(const muse::ByteArray& data);
+
+    static muse::Ret write(const muse::io::path_t& cachePath, const muse::ByteArray& sourceData,
+                           const std::vector<std::pair<muse::String, muse::ByteArray> >& files);
+
+    muse::Ret open(const muse::io::path_t& cachePath, const muse::ByteArray& sourceData);
+    void close();
+    bool isOpened() const;
+
+    muse::StringList fileList() const;
+    bool fileExists(const muse::String& fileName) const;
+    muse::ByteArray fileData(const muse::String& fileName, bool shared) const;
+
+private:
+    static inline muse::GlobalInject<muse::io::IFileSystem> fileSystem;
+
+    struct Entry {
+        size_t offset = 0;
+        size_t size = 0;
+    };
+
+    std::unique_ptr<muse::io::MappedFile> m_file;
+    std::map<muse::String, Entry> m_entries;
+};
+}
+
+#endif // MU_ENGRAVING_MSCCACHE_H
@@ -22,12 +22,15 @@
 #include "mscreader.h"
 
 #include "io/file.h"
+#include "io/mappedfile.h"
 #include "io/fileinfo.h"
 #include "io/dir.h"
 #include "serialization/zipreader.h"
 #include "serialization/xmlstreamreader.h"
 #include "engraving/engravingerrors.h"
 
+#include "msccache.h"
+
 #include "log.h"
 
 //! NOTE The current implementation resolves files by extension.
@@ -92,7 +95,7 @@ MscReader::IReader* MscReader::reader() const
     if (!m_reader) {
         switch (m_params.mode) {
         case MscIoMode::Zip:
-            m_reader = new ZipFileReader();
+            m_reader = new ZipFileReader(m_params.useCache);
             break;
         case MscIoMode::Dir:
             m_reader = new DirReader();
@@ -114,9 +117,9 @@ bool MscReader::fileExists(const String& fileName) const
     return reader()->fileExists(fileName);
 }
 
-ByteArray MscReader::fileData(const String& fileName) const
+ByteArray MscReader::fileData(const String& fileName, bool shared) const
 {
-    return reader()->fileData(fileName);
+    return reader()->fileData(fileName, shared);
 }
 
 ByteArray MscReader::readStyleFile() const
@@ -149,7 +152,7 @@ String MscReader::mainFileName() const
 ByteArray MscReader::readScoreFile() const
 {
     String mscxFileName = mainFileName();
-    ByteArray data = fileData(mscxFileName);
+    ByteArray data = fileData(mscxFileName, true);
     if (data.empty() && reader()->isContainer()) {
         StringList files = reader()->fileList();
         for (const String& name : files) {
@@ -161,7 +164,7 @@ ByteArray MscReader::readScoreFile() const
         }
     }
 
-    return fileData(mscxFileName);
+    return fileData(mscxFileName, true);
 }
 
 std::vector<String> MscReader::excerptFileNames() const
@@ -190,7 +193,7 @@ ByteArray MscReader::readExcerptStyleFile(const String& excerptFileName) const
 ByteArray MscReader::readExcerptFile(const String& excerptFileName) const
 {
     String fileName = excerptFileName + u".mscx";
-    return fileData(u"Excerpts/" + excerptFileName + u"/" + fileName);
+    return fileData(u"Excerpts/" + excerptFileName + u"/" + fileName, true);
 }
 
 ByteArray MscReader::readChordListFile() const
@@ -211,6 +214,11 @@ ByteArray MscReader::readImageFile(const String& fileName) const
     return fileData(u"Pictures/" + fileName);
 }
 
+ZipReader::RawFileData MscReader::readRawImageFile(const String& fileName) const
+{
+    return reader()->rawFileData(u"Pictures/" + fileName);
+}
+
 std::vector<String> MscReader::imageFileNames() const
 {
     if (!reader()->isContainer()) {
@@ -243,12 +251,21 @@ ByteArray MscReader::readViewSettingsJsonFile(const muse::io::path_t& pathPrefix
     return fileData(pathPrefix.toString() + u"viewsettings.json");
 }
 
+ByteArray MscReader::readScoreMetaJsonFile() const
+{
+    if (!fileExists(u"scoremeta.json")) {
+        return ByteArray();
+    }
+    return fileData(u"scoremeta.json");
+}
+
 // =======================================================================
 // Readers
 // =======================================================================
 
 MscReader::ZipFileReader::~ZipFileReader()
 {
+    delete m_cache;
     delete m_zip;
     if (m_selfDeviceOwner) {
         delete m_device;
@@ -264,7 +281,7 @@ Ret MscReader::ZipFileReader::open(IODevice* device, const path_t& filePath)
             return make_ret(Err::FileNotFound, filePath);
         }
 
-        m_device = new File(filePath);
+        m_device = new MappedFile(filePath);
         m_selfDeviceOwner = true;
     }
 
@@ -277,11 +294,50 @@ Ret MscReader::ZipFileReader::open(IODevice* device, const path_t& filePath)
 
     m_zip = new ZipReader(m_device);
 
+    if (m_useCache && m_selfDeviceOwner) {
+        openCache(filePath);
+    }
+
     return true;
 }
 
+void MscReader::ZipFileReader::openCache(const path_t& filePath)
+{
+    TRACEFUNC;
+
+    const size_t pos = m_device->pos();
+    m_device->seek(0);
+    ByteArray sourceData = m_device->readShared(m_device->size());
+    m_device->seek(pos);
+
+    path_t cachePath = MscCache::cachePath(filePath);
+    MscCache* cache = new MscCache();
+    if (cache->open(cachePath, sourceData)) {
+        m_cache = cache;
+        return;
+    }
+
+    // Make it from the zip, so that the files are unpacked just once
+    std::vector<std::pair<String, ByteArray> > files;
+    for (const String& fileName : fileList()) {
+        files.push_back({ fileName, fileData(fileName, false) });
+    }
+
+    if (MscCache::write(cachePath, sourceData, files) && cache->open(cachePath, sourceData)) {
+        m_cache = cache;
+        return;
+    }
+
+    LOGW() << "failed to make cache: " << cachePath;
+    delete cache;
+}
+
 void MscReader::ZipFileReader::close()
 {
+    if (m_cache) {
+        m_cache->close();
+    }
+
     if (m_zip) {
         m_zip->close();
     }
@@ -303,6 +359,10 @@ bool MscReader::ZipFileReader::isContainer() const
 
 StringList MscReader::ZipFileReader::fileList() const
 {
+    if (m_cache) {
+        return m_cache->fileList();
+    }
+
     IF_ASSERT_FAILED(m_zip) {
         return StringList();
     }
@@ -324,6 +384,10 @@ StringList MscReader::ZipFileReader::fileList() const
 
 bool MscReader::ZipFileReader::fileExists(const String& fileName) const
 {
+    if (m_cache) {
+        return m_cache->fileExists(fileName);
+    }
+
     IF_ASSERT_FAILED(m_zip) {
         return false;
     }
@@ -331,13 +395,17 @@ bool MscReader::ZipFileReader::fileExists(const String& fileName) const
     return m_zip->fileExists(fileName.toStdString());
 }
 
-ByteArray MscReader::ZipFileReader::fileData(const String& fileName) const
+ByteArray MscReader::ZipFileReader::fileData(const String& fileName, bool shared) const
 {
+    if (m_cache) {
+        return m_cache->fileData(fileName, shared);
+    }
+
     IF_ASSERT_FAILED(m_zip) {
         return ByteArray();
     }
 
-    ByteArray data = m_zip->fileData(fileName.toStdString());
+    ByteArray data = m_zip->fileData(fileName.toStdString(), shared);
     if (m_zip->hasError()) {
         LOGE() << "failed read data for filename " << fileName;
         return ByteArray();
@@ -345,6 +413,24 @@ ByteArray MscReader::ZipFileReader::fileData(const String& fileName) const
     return data;
 }
 
+ZipReader::RawFileData MscReader::ZipFileReader::rawFileData(const String& fileName) const
+{
+    if (m_cache) {
+        return IReader::rawFileData(fileName);
+    }
+
+    IF_ASSERT_FAILED(m_zip) {
+        return ZipReader::RawFileData();
+    }
+
+    ZipReader::RawFileData raw = m_zip->rawFileData(fileName.toStdString());
+    if (m_zip->hasError()) {
+        LOGE() << "failed read data for filename " << fileName;
+        return ZipReader::RawFileData();
+    }
+    return raw;
+}
+
 Ret MscReader::DirReader::open(IODevice* device, const path_t& filePath)
 {
     if (device) {
@@ -402,9 +488,20 @@ bool MscReader::DirReader::fileExists(const String& fileName) const
     return File::exists(filePath);
 }
 
-ByteArray MscReader::DirReader::fileData(const String& fileName) const
+ByteArray MscReader::DirReader::fileData(const String& fileName, bool shared) const
 {
     muse::io::path_t filePath = m_rootPath + "/" + fileName;
+    if (shared) {
+        MappedFile file(filePath);
+        if (!file.open(IODevice::ReadOnly)) {
+            LOGE() << "failed open file: " << filePath;
+            return ByteArray();
+        }
+
+        // the data keeps the mapping alive
+        return file.readShared(file.size());
+    }
+
     File file(filePath);
     if (!file.open(IODevice::ReadOnly)) {
         LOGE() << "failed open file: " << filePath;
@@ -423,7 +520,7 @@ Ret MscReader::XmlFileReader::open(IODevice* device, const path_t& filePath)
             return make_ret(Err::FileNotFound, filePath);
         }
 
-        m_device = new File(filePath);
+        m_device = new MappedFile(filePath);
         m_selfDeviceOwner = true;
     }
 
@@ -514,7 +611,7 @@ bool MscReader::XmlFileReader::fileExists(const String& fileName) const
     return false;
 }
 
-ByteArray MscReader::XmlFileReader::fileData(const String& fileName) const
+ByteArray MscReader::XmlFileReader::fileData(const String& fileName, bool) const
 {
     if (!m_device) {
         return ByteArray();
@@ -26,13 +26,11 @@
 #include "types/string.h"
 #include "io/path.h"
 #include "io/iodevice.h"
+#include "serialization/zipreader.h"
 #include "mscio.h"
 
-namespace muse {
-class ZipReader;
-}
-
 namespace mu::engraving {
+class MscCache;
 class MscReader
 {
 public:
@@ -43,6 +41,9 @@ public:
         muse::io::path_t filePath;
         muse::String mainFileName;
         MscIoMode mode = MscIoMode::Zip;
+        //! NOTE Read a zip file through its unpacked copy next to it (see MscCache),
+        //! which is made on the first read
+        bool useCache = false;
     };
 
     MscReader() = default;
@@ -57,6 +58,8 @@ public:
     bool isOpened() const;
 
     muse::ByteArray readStyleFile() const;
+    //! NOTE The score and excerpt data may refer to the memory-mapped file
+    //! instead of being copied, they are supposed to be parsed and released
     muse::ByteArray readScoreFile() const;
 
     std::vector<muse::String> excerptFileNames() const;
@@ -68,10 +71,13 @@ public:
 
     std::vector<muse::String> imageFileNames() const;
     muse::ByteArray readImageFile(const muse::String& fileName) const;
+    //! NOTE The image data as it is stored in the container, see ZipReader::uncompressedData
+    muse::ZipReader::RawFileData readRawImageFile(const muse::String& fileName) const;
 
     muse::ByteArray readAudioFile() const;
     muse::ByteArray readAudioSettingsJsonFile(const muse::io::path_t& pathPrefix = "") const;
     muse::ByteArray readViewSettingsJsonFile(const muse::io::path_t& pathPrefix = "") const;
+    muse::ByteArray readScoreMetaJsonFile() const;
 
 private:
 
@@ -87,11 +93,19 @@ private:
         virtual bool isContainer() const = 0;
         virtual muse::StringList fileList() const = 0;
         virtual bool fileExists(const muse::String& fileName) const = 0;
-        virtual muse::ByteArray fileData(const muse::String& fileName) const = 0;
+        virtual muse::ByteArray fileData(const muse::String& fileName, bool shared) const = 0;
+        virtual muse::ZipReader::RawFileData rawFileData(const muse::String& fileName) const
+        {
+            muse::ByteArray data = fileData(fileName, false);
+            const size_t size = data.size();
+            return { std::move(data), false, size };
+        }
     };
 
     struct ZipFileReader : public IReader
     {
+        ZipFileReader(bool useCache)
+            : m_useCache(useCache) {}
         ~ZipFileReader() override;
         muse::Ret open(muse::io::IODevice* device, const muse::io::path_t& filePath) override;
         void close() override;
@@ -99,11 +113,16 @@ private:
         bool isContainer() const override;
         muse::StringList fileList() const override;
         bool fileExists(const muse::String& fileName) const override;
-        muse::ByteArray fileData(const muse::String& fileName) const override;
+        muse::ByteArray fileData(const muse::String& fileName, bool shared) const override;
+        muse::ZipReader::RawFileData rawFileData(const muse::String& fileName) const override;
     private:
+        void openCache(const muse::io::path_t& filePath);
+
         muse::io::IODevice* m_device = nullptr;
         bool m_selfDeviceOwner = false;
         muse::ZipReader* m_zip = nullptr;
+        bool m_useCache = false;
+        MscCache* m_cache = nullptr;
     };
 
     struct DirReader : public IReader
@@ -114,7 +133,7 @@ private:
         bool isContainer() const override;
         muse::StringList fileList() const override;
         bool fileExists(const muse::String& fileName) const override;
-        muse::ByteArray fileData(const muse::String& fileName) const override;
+        muse::ByteArray fileData(const muse::String& fileName, bool shared) const override;
     private:
         muse::io::path_t m_rootPath;
     };
@@ -127,7 +146,7 @@ private:
         bool isContainer() const override;
         muse::StringList fileList() const override;
         bool fileExists(const muse::String& fileName) const override;
-        muse::ByteArray fileData(const muse::String& fileName) const override;
+        muse::ByteArray fileData(const muse::String& fileName, bool shared) const override;
     private:
         muse::io::IODevice* m_device = nullptr;
         bool m_selfDeviceOwner = false;
@@ -135,7 +154,7 @@ private:
 
     IReader* reader() const;
     bool fileExists(const muse::String& fileName) const;
-    muse::ByteArray fileData(const muse::String& fileName) const;
+    muse::ByteArray fileData(const muse::String& fileName, bool shared = false) const;
 
     muse::String mainFileName() const;
 
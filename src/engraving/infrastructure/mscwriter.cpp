@@ -203,6 +203,11 @@ void MscWriter::writeViewSettingsJsonFile(const ByteArray& data, const muse::io:
     addFileData(pathPrefix.toString() + u"viewsettings.json", data);
 }
 
+void MscWriter::writeScoreMetaJsonFile(const ByteArray& data)
+{
+    addFileData(u"scoremeta.json", data);
+}
+
 void MscWriter::writeMeta()
 {
     if (m_meta.isWritten) {
@@ -278,6 +283,8 @@ Ret MscWriter::ZipFileWriter::open(io::IODevice* device, const path_t& filePath)
     }
 
     m_zip = new ZipWriter(m_device);
+    // excerpts, images and so on are compressed in parallel when the file is closed
+    m_zip->setDeferredCompression(true);
 
     return true;
 }
@@ -68,6 +68,7 @@ public:
     void writeAudioFile(const muse::ByteArray& data);
     void writeAudioSettingsJsonFile(const muse::ByteArray& data, const muse::io::path_t& pathPrefix = "");
     void writeViewSettingsJsonFile(const muse::ByteArray& data, const muse::io::path_t& pathPrefix = "");
+    void writeScoreMetaJsonFile(const muse::ByteArray& data);
 
 private:
 
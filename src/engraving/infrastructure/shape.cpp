@@ -19,6 +19,7 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
+#include <algorithm>
 #include <cfloat>
 
 #include "shape.h"
@@ -537,6 +538,49 @@ bool Shape::intersects(const Shape& other) const
     return false;
 }
 
+//---------------------------------------------------------
+//   ShapeYIndex
+//---------------------------------------------------------
+
+void ShapeYIndex::add(const ShapeElement* el)
+{
+    Entry e;
+    e.top = el->top();
+    e.bottom = el->bottom();
+    e.element = el;
+    m_entries.push_back(e);
+}
+
+void ShapeYIndex::build()
+{
+    std::stable_sort(m_entries.begin(), m_entries.end(), [](const Entry& a, const Entry& b) {
+        return a.top < b.top;
+    });
+
+    double maxBottom = -DBL_MAX;
+    for (Entry& e : m_entries) {
+        maxBottom = std::max(maxBottom, e.bottom);
+        e.maxBottom = maxBottom;
+    }
+}
+
+size_t ShapeYIndex::beginIndex(double y1, double clearance) const
+{
+    // maxBottom is not decreasing, so all entries before the first one reaching y1 end above it
+    auto it = std::partition_point(m_entries.begin(), m_entries.end(), [y1, clearance](const Entry& e) {
+        return !(e.maxBottom + clearance > y1);
+    });
+    return std::distance(m_entries.begin(), it);
+}
+
+size_t ShapeYIndex::endIndex(double y2, double clearance) const
+{
+    auto it = std::partition_point(m_entries.begin(), m_entries.end(), [y2, clearance](const Entry& e) {
+        return e.top < y2 + clearance;
+    });
+    return std::distance(m_entries.begin(), it);
+}
+
 void Shape::paint(Painter& painter) const
 {
     for (const RectF& r : m_elements) {
@@ -175,6 +175,52 @@ private:
     mutable RectF m_bbox;   // cache
 };
 
+//---------------------------------------------------------
+//   ShapeYIndex
+//    Elements of a shape sorted by their top edge, to find
+//    the ones in a vertical range in O(log n + k) instead
+//    of visiting all of them.
+//---------------------------------------------------------
+
+class ShapeYIndex
+{
+public:
+    void reserve(size_t n) { m_entries.reserve(n); }
+    void clear() { m_entries.clear(); }
+    void add(const ShapeElement* el);
+    void build();
+
+    size_t size() const { return m_entries.size(); }
+    bool empty() const { return m_entries.empty(); }
+
+    // calls func for each element E that may intersect [y1, y2] with the given clearance,
+    // i.e. E.top < y2 + clearance && E.bottom + clearance > y1
+    template<typename Func>
+    void forEachInRange(double y1, double y2, double clearance, Func func) const
+    {
+        const size_t end = endIndex(y2, clearance);
+        for (size_t i = beginIndex(y1, clearance); i < end; ++i) {
+            const Entry& e = m_entries[i];
+            if (e.bottom + clearance > y1) {
+                func(*e.element);
+            }
+        }
+    }
+
+private:
+    struct Entry {
+        double top = 0.0;
+        double bottom = 0.0;
+        double maxBottom = 0.0; // max of bottom over this and all previous entries
+        const ShapeElement* element = nullptr;
+    };
+
+    size_t beginIndex(double y1, double clearance) const;
+    size_t endIndex(double y2, double clearance) const;
+
+    std::vector<Entry> m_entries;
+};
+
 void dump(const ShapeElement& sh, std::stringstream& ss);
 void dump(const Shape& sh, std::stringstream& ss);
 std::string dump(const Shape& sh);
@@ -22,6 +22,8 @@
 
 #include "skyline.h"
 
+#include <algorithm>
+
 #include "realfn.h"
 #include "draw/painter.h"
 
@@ -103,6 +105,7 @@ SkylineLine SkylineLine::getFilteredCopy(std::function<bool(const ShapeElement&)
     SkylineLine newSkylineLine(*this);
 
     newSkylineLine.m_shape.clear();
+    newSkylineLine.m_intervalsValid = false;
 
     for (const ShapeElement& shapeEl : m_shape.elements()) {
         if (filterOut(shapeEl)) {
@@ -140,6 +143,7 @@ void SkylineLine::add(const ShapeElement& r)
     }
 
     m_shape.add(r);
+    m_intervalsValid = false;
 }
 
 double SkylineLine::staffLinesTopAtX(double x) const
@@ -187,6 +191,7 @@ void SkylineLine::clear()
 {
     m_staffLineEdges.clear();
     m_shape.clear();
+    m_intervalsValid = false;
 }
 
 //-------------------------------------------------------------------
@@ -200,29 +205,209 @@ double Skyline::minDistance(const Skyline& s, double minHorizontalClearance) con
     return south().minDistance(s.north(), minHorizontalClearance);
 }
 
+//-------------------------------------------------------------------
+//   Intervals::build
+//-------------------------------------------------------------------
+
+void SkylineLine::Intervals::Rects::clear()
+{
+    left.clear();
+    right.clear();
+    top.clear();
+    bottom.clear();
+}
+
+void SkylineLine::Intervals::Rects::add(const ShapeElement& el)
+{
+    left.push_back(el.left());
+    right.push_back(el.right());
+    top.push_back(el.top());
+    bottom.push_back(el.bottom());
+}
+
+void SkylineLine::Intervals::build(const std::vector<ShapeElement>& elements)
+{
+    order.clear();
+    double extentLeft = DBL_MAX;
+    double extentRight = -DBL_MAX;
+    for (const ShapeElement& el : elements) {
+        // the same elements Shape::minVerticalDistance skips
+        if (el.height() <= 0.0 || el.left() == el.right()) {
+            continue;
+        }
+        order.push_back(&el);
+        extentLeft = std::min(extentLeft, el.left());
+        extentRight = std::max(extentRight, el.right());
+    }
+
+    std::stable_sort(order.begin(), order.end(), [](const ShapeElement* a, const ShapeElement* b) {
+        return a->left() < b->left();
+    });
+
+    narrow.clear();
+    wide.clear();
+    maxRight.clear();
+
+    const double wideWidth = (extentRight - extentLeft) / 4;
+    double reach = -DBL_MAX;
+    for (const ShapeElement* el : order) {
+        if (el->width() > wideWidth) {
+            wide.add(*el);
+            continue;
+        }
+        narrow.add(*el);
+        reach = std::max(reach, el->right());
+        maxRight.push_back(reach);
+    }
+}
+
+const SkylineLine::Intervals& SkylineLine::intervals() const
+{
+    if (!m_intervalsValid) {
+        m_intervals.build(m_shape.elements());
+        m_intervalsValid = true;
+    }
+    return m_intervals;
+}
+
+const SkylineLine::Intervals& SkylineLine::scratchIntervals(const Shape& shape)
+{
+    // reused between the queries, the layout of a score may run on several threads
+    thread_local Intervals scratch;
+    scratch.build(shape.elements());
+    return scratch;
+}
+
+//-------------------------------------------------------------------
+//   isSmallQuery
+//    Below this number of pairs sorting the shape costs more than
+//    comparing all the pairs
+//-------------------------------------------------------------------
+
+static constexpr size_t PAIRWISE_MAX_PAIRS = 256;
+
+bool SkylineLine::isSmallQuery(const Shape& a, const Shape& b)
+{
+    return a.size() * b.size() <= PAIRWISE_MAX_PAIRS;
+}
+
+//-------------------------------------------------------------------
+//   maxOverlap
+//    lower is located below upper.
+//    Returns the max of (upper.bottom - lower.top) over all pairs of
+//    horizontally intersecting elements, -DBL_MAX if there are none.
+//    Same result as Shape::minVerticalDistance, but both sides are
+//    sorted, so only the elements in the x-window of each lower
+//    element are visited.
+//-------------------------------------------------------------------
+
+double SkylineLine::maxOverlapPairwise(const Intervals::Rects& upper, const Intervals::Rects& lower, double minHorizontalClearance)
+{
+    double dist = -DBL_MAX;
+    for (size_t j = 0; j < lower.size(); ++j) {
+        const double bx1 = lower.left[j];
+        const double bx2 = lower.right[j];
+        const double by = lower.top[j];
+        for (size_t i = 0; i < upper.size(); ++i) {
+            if (upper.right[i] + minHorizontalClearance > bx1 && upper.left[i] < bx2 + minHorizontalClearance) {
+                dist = std::max(dist, upper.bottom[i] - by);
+            }
+        }
+    }
+    return dist;
+}
+
+double SkylineLine::maxOverlap(const Intervals& upper, const Intervals& lower, double minHorizontalClearance)
+{
+    const double clearance = minHorizontalClearance;
+    const Intervals::Rects& u = upper.narrow;
+    const Intervals::Rects& l = lower.narrow;
+    const size_t upperSize = u.size();
+    const double* uLeft = u.left.data();
+    const double* uRight = u.right.data();
+    const double* uMaxRight = upper.maxRight.data();
+    const double* uBottom = u.bottom.data();
+
+    double dist = -DBL_MAX;
+    size_t start = 0;
+    for (size_t j = 0; j < l.size(); ++j) {
+        const double bx1 = l.left[j];
+        const double bx2 = l.right[j];
+        const double by = l.top[j];
+
+        // lower is sorted by left edge, so the elements that end before this one end before all the next ones too
+        while (start < upperSize && !(uMaxRight[start] + clearance > bx1)) {
+            ++start;
+        }
+
+        const double windowEnd = bx2 + clearance;
+        for (size_t i = start; i < upperSize && uLeft[i] < windowEnd; ++i) {
+            const double d = (uRight[i] + clearance > bx1) ? uBottom[i] - by : -DBL_MAX;
+            dist = std::max(dist, d);
+        }
+    }
+
+    // the wide elements are few, so they are compared with everything
+    dist = std::max(dist, maxOverlapPairwise(upper.wide, l, clearance));
+    dist = std::max(dist, maxOverlapPairwise(upper.wide, lower.wide, clearance));
+    dist = std::max(dist, maxOverlapPairwise(u, lower.wide, clearance));
+
+    return dist;
+}
+
 double SkylineLine::minDistance(const SkylineLine& sl, double minHorizontalClearance) const
 {
-    return m_shape.minVerticalDistance(sl.m_shape, minHorizontalClearance);
+    if (m_shape.empty() || sl.m_shape.empty()) {
+        return 0.0;
+    }
+    if (isSmallQuery(m_shape, sl.m_shape)) {
+        return m_shape.minVerticalDistance(sl.m_shape, minHorizontalClearance);
+    }
+    return maxOverlap(intervals(), sl.intervals(), minHorizontalClearance);
 }
 
 double SkylineLine::minDistanceToShapeAbove(const Shape& shapeAbove, double minHorizontalClearance) const
 {
-    return shapeAbove.minVerticalDistance(m_shape, minHorizontalClearance);
+    if (m_shape.empty() || shapeAbove.empty()) {
+        return 0.0;
+    }
+    if (isSmallQuery(shapeAbove, m_shape)) {
+        return shapeAbove.minVerticalDistance(m_shape, minHorizontalClearance);
+    }
+    return maxOverlap(scratchIntervals(shapeAbove), intervals(), minHorizontalClearance);
 }
 
 double SkylineLine::minDistanceToShapeBelow(const Shape& shapeBelow, double minHorizontalClearance) const
 {
-    return m_shape.minVerticalDistance(shapeBelow, minHorizontalClearance);
+    if (m_shape.empty() || shapeBelow.empty()) {
+        return 0.0;
+    }
+    if (isSmallQuery(m_shape, shapeBelow)) {
+        return m_shape.minVerticalDistance(shapeBelow, minHorizontalClearance);
+    }
+    return maxOverlap(intervals(), scratchIntervals(shapeBelow), minHorizontalClearance);
 }
 
 double SkylineLine::verticalClearanceAbove(const Shape& shapeAbove) const
 {
-    return shapeAbove.verticalClearance(m_shape);
+    if (m_shape.empty() || shapeAbove.empty()) {
+        return 0.0;
+    }
+    if (isSmallQuery(shapeAbove, m_shape)) {
+        return shapeAbove.verticalClearance(m_shape);
+    }
+    return -maxOverlap(scratchIntervals(shapeAbove), intervals(), 0.0);
 }
 
 double SkylineLine::verticalClaranceBelow(const Shape& shapeBelow) const
 {
-    return m_shape.verticalClearance(shapeBelow);
+    if (m_shape.empty() || shapeBelow.empty()) {
+        return 0.0;
+    }
+    if (isSmallQuery(m_shape, shapeBelow)) {
+        return m_shape.verticalClearance(shapeBelow);
+    }
+    return -maxOverlap(intervals(), scratchIntervals(shapeBelow), 0.0);
 }
 
 void Skyline::paint(Painter& painter, double lineWidth) const // DEBUG only
@@ -268,6 +453,7 @@ bool SkylineLine::valid() const
 SkylineLine& SkylineLine::translateY(double y)
 {
     m_shape.translateY(y);
+    m_intervalsValid = false;
     return *this;
 }
 
@@ -52,7 +52,11 @@ public:
     void add(const Shape& s);
 
     template<typename Predicate>
-    inline bool remove_if(Predicate p) { return m_shape.remove_if(p); }
+    inline bool remove_if(Predicate p)
+    {
+        m_intervalsValid = false;
+        return m_shape.remove_if(p);
+    }
     SkylineLine getFilteredCopy(std::function<bool(const ShapeElement&)> filterOut) const;
 
     void clear();
@@ -74,9 +78,45 @@ public:
     bool isNorth() const { return m_isNorth; }
 
     const std::vector<ShapeElement>& elements() const { return m_shape.elements(); }
-    std::vector<ShapeElement>& elements() { return m_shape.elements(); }
+    std::vector<ShapeElement>& elements()
+    {
+        m_intervalsValid = false;
+        return m_shape.elements();
+    }
 
 private:
+    //! NOTE Structure-of-arrays copy of the shape, sorted by the left edge.
+    //! Only the elements that can collide (non-zero width and height) are kept.
+    //! The elements much wider than the others (like the staff lines) are kept apart,
+    //! otherwise they would stretch the maxRight window over the whole line.
+    struct Intervals {
+        struct Rects {
+            std::vector<double> left;
+            std::vector<double> right;
+            std::vector<double> top;
+            std::vector<double> bottom;
+
+            void clear();
+            void add(const ShapeElement& el);
+            size_t size() const { return left.size(); }
+        };
+
+        Rects narrow;
+        std::vector<double> maxRight; // max of narrow right over [0, i], to skip the elements that end before a query
+        Rects wide;
+
+        std::vector<const ShapeElement*> order; // scratch for build
+
+        void build(const std::vector<ShapeElement>& elements);
+    };
+
+    static double maxOverlap(const Intervals& upper, const Intervals& lower, double minHorizontalClearance);
+    static double maxOverlapPairwise(const Intervals::Rects& upper, const Intervals::Rects& lower, double minHorizontalClearance);
+
+    const Intervals& intervals() const;
+    static const Intervals& scratchIntervals(const Shape& shape);
+    static bool isSmallQuery(const Shape& a, const Shape& b);
+
     double staffLinesTopAtX(double x) const;
     double staffLinesBottomAtX(double x) const;
 
@@ -84,6 +124,10 @@ private:
     const bool m_isNorth;
     Shape m_shape;
 
+    // built on demand by the distance queries, so not safe to query the same line from several threads
+    mutable Intervals m_intervals;
+    mutable bool m_intervalsValid = false;
+
     struct StaffLineEdge {
         double top = 0.0;
         double bottom = 0.0;
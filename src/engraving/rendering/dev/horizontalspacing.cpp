@@ -45,6 +45,14 @@ using namespace mu::engraving::rendering::dev;
 //-------------------------------------------------------------------
 
 double HorizontalSpacing::minHorizontalDistance(const Shape& f, const Shape& s, double spatium, double squeezeFactor)
+{
+    if (f.size() * s.size() >= Y_INDEX_MIN_PAIRS) {
+        return minHorizontalDistanceIndexed(f, s, spatium, squeezeFactor);
+    }
+    return minHorizontalDistancePairwise(f, s, spatium, squeezeFactor);
+}
+
+double HorizontalSpacing::minHorizontalDistancePairwise(const Shape& f, const Shape& s, double spatium, double squeezeFactor)
 {
     double dist = -DBL_MAX;        // min real
     double absoluteMinPadding = 0.1 * spatium * squeezeFactor;
@@ -52,37 +60,132 @@ double HorizontalSpacing::minHorizontalDistance(const Shape& f, const Shape& s,
         if (r2.isNull()) {
             continue;
         }
-        const EngravingItem* item2 = r2.item();
-        double by1 = r2.top();
-        double by2 = r2.bottom();
         for (const ShapeElement& r1 : f.elements()) {
             if (r1.isNull()) {
                 continue;
             }
-            const EngravingItem* item1 = r1.item();
-            double ay1 = r1.top();
-            double ay2 = r1.bottom();
-            double verticalClearance = computeVerticalClearance(item1, item2, spatium) * squeezeFactor;
-            bool intersection = mu::engraving::intersects(ay1, ay2, by1, by2, verticalClearance);
-            double padding = 0;
-            KerningType kerningType = KerningType::NON_KERNING;
-            if (item1 && item2) {
-                padding = computePadding(item1, item2);
-                padding *= squeezeFactor;
-                padding = std::max(padding, absoluteMinPadding);
-                kerningType = computeKerning(item1, item2);
-            }
-            if ((intersection && kerningType != KerningType::ALLOW_COLLISION)
-                || (r1.width() == 0 || r2.width() == 0)  // Temporary hack: shapes of zero-width are assumed to collide with everyghin
-                || (!item1 && item2 && item2->isLyrics())  // Temporary hack: avoids collision with melisma line
-                || kerningType == KerningType::NON_KERNING) {
-                dist = std::max(dist, r1.right() - r2.left() + padding);
+            dist = std::max(dist, shapeElementsDistance(r1, r2, spatium, squeezeFactor, absoluteMinPadding));
+        }
+    }
+    return dist;
+}
+
+//-------------------------------------------------------------------
+//   minHorizontalDistanceIndexed
+//    Same result as minHorizontalDistance for big shapes.
+//    A pair of kernable elements only needs space if the elements
+//    overlap vertically, so for those pairs only the elements of f
+//    near the height of each element of s are visited.
+//-------------------------------------------------------------------
+
+double HorizontalSpacing::minHorizontalDistanceIndexed(const Shape& f, const Shape& s, double spatium, double squeezeFactor)
+{
+    // reused between the calls, the layout of a score may run on several threads
+    thread_local ShapeYIndex kernableIndex;
+    thread_local std::vector<const ShapeElement*> others;
+    kernableIndex.clear();
+    others.clear();
+
+    for (const ShapeElement& r1 : f.elements()) {
+        if (r1.isNull()) {
+            continue;
+        }
+        if (isKernableLeft(r1)) {
+            kernableIndex.add(&r1);
+        } else {
+            others.push_back(&r1);
+        }
+    }
+    kernableIndex.build();
+
+    double dist = -DBL_MAX;        // min real
+    double absoluteMinPadding = 0.1 * spatium * squeezeFactor;
+    for (const ShapeElement& r2 : s.elements()) {
+        if (r2.isNull()) {
+            continue;
+        }
+
+        if (!isKernableRight(r2)) {
+            for (const ShapeElement& r1 : f.elements()) {
+                if (r1.isNull()) {
+                    continue;
+                }
+                dist = std::max(dist, shapeElementsDistance(r1, r2, spatium, squeezeFactor, absoluteMinPadding));
             }
+            continue;
+        }
+
+        for (const ShapeElement* r1 : others) {
+            dist = std::max(dist, shapeElementsDistance(*r1, r2, spatium, squeezeFactor, absoluteMinPadding));
         }
+
+        // the vertical clearance doesn't depend on item1
+        double verticalClearance = computeVerticalClearance(nullptr, r2.item(), spatium) * squeezeFactor;
+        kernableIndex.forEachInRange(r2.top(), r2.bottom(), verticalClearance, [&](const ShapeElement& r1) {
+            dist = std::max(dist, shapeElementsDistance(r1, r2, spatium, squeezeFactor, absoluteMinPadding));
+        });
     }
     return dist;
 }
 
+//-------------------------------------------------------------------
+//   shapeElementsDistance
+//    r2 is located right of r1.
+//    Returns the distance r2 must keep from r1, -DBL_MAX if they may collide.
+//-------------------------------------------------------------------
+
+double HorizontalSpacing::shapeElementsDistance(const ShapeElement& r1, const ShapeElement& r2, double spatium, double squeezeFactor,
+                                                double absoluteMinPadding)
+{
+    const EngravingItem* item1 = r1.item();
+    const EngravingItem* item2 = r2.item();
+    double verticalClearance = computeVerticalClearance(item1, item2, spatium) * squeezeFactor;
+    bool intersection = mu::engraving::intersects(r1.top(), r1.bottom(), r2.top(), r2.bottom(), verticalClearance);
+    double padding = 0;
+    KerningType kerningType = KerningType::NON_KERNING;
+    if (item1 && item2) {
+        padding = computePadding(item1, item2);
+        padding *= squeezeFactor;
+        padding = std::max(padding, absoluteMinPadding);
+        kerningType = computeKerning(item1, item2);
+    }
+    if ((intersection && kerningType != KerningType::ALLOW_COLLISION)
+        || (r1.width() == 0 || r2.width() == 0)  // Temporary hack: shapes of zero-width are assumed to collide with everyghin
+        || (!item1 && item2 && item2->isLyrics())  // Temporary hack: avoids collision with melisma line
+        || kerningType == KerningType::NON_KERNING) {
+        return r1.right() - r2.left() + padding;
+    }
+    return -DBL_MAX;
+}
+
+//-------------------------------------------------------------------
+//   isKernableLeft / isKernableRight
+//    A pair of a kernable left and a kernable right element is
+//    always KerningType::KERNING (see computeKerning), so it only
+//    needs space if the elements intersect vertically.
+//-------------------------------------------------------------------
+
+bool HorizontalSpacing::isKernableLeft(const ShapeElement& r1)
+{
+    const EngravingItem* item1 = r1.item();
+    if (!item1 || r1.width() == 0) {
+        return false;
+    }
+
+    if (isSameVoiceKerningLimited(item1) || isNeverKernable(item1)) {
+        return false;
+    }
+
+    // types with their own rules are not always kernable
+    return !kerningTypeRule(item1->type());
+}
+
+bool HorizontalSpacing::isKernableRight(const ShapeElement& r2)
+{
+    const EngravingItem* item2 = r2.item();
+    return item2 && r2.width() != 0 && !isNeverKernable(item2);
+}
+
 // Logic moved from Shape
 double HorizontalSpacing::shapeSpatium(const Shape& s)
 {
@@ -552,27 +655,50 @@ bool HorizontalSpacing::isAlwaysKernable(const EngravingItem* item)
     return item->isTextBase() || item->isChordLine();
 }
 
-KerningType HorizontalSpacing::doComputeKerningType(const EngravingItem* item1, const EngravingItem* item2)
+//-------------------------------------------------------------------
+//   kerningTypeRule
+//    The kerning type rule of the items of type1 on the left,
+//    nullptr if they always kern.
+//-------------------------------------------------------------------
+
+HorizontalSpacing::KerningTypeRule HorizontalSpacing::kerningTypeRule(ElementType type1)
 {
-    ElementType type1 = item1->type();
     switch (type1) {
     case ElementType::BAR_LINE:
-        return KerningType::NON_KERNING;
+        return [](const EngravingItem*, const EngravingItem*) {
+            return KerningType::NON_KERNING;
+        };
     case ElementType::CHORDLINE:
-        return item2->isBarLine() ? KerningType::ALLOW_COLLISION : KerningType::KERNING;
+        return [](const EngravingItem*, const EngravingItem* item2) {
+            return item2->isBarLine() ? KerningType::ALLOW_COLLISION : KerningType::KERNING;
+        };
     case ElementType::HARMONY:
-        return item2->isHarmony() ? KerningType::NON_KERNING : KerningType::KERNING;
+        return [](const EngravingItem*, const EngravingItem* item2) {
+            return item2->isHarmony() ? KerningType::NON_KERNING : KerningType::KERNING;
+        };
     case ElementType::LYRICS:
-        return computeLyricsKerningType(toLyrics(item1), item2);
+        return [](const EngravingItem* item1, const EngravingItem* item2) {
+            return computeLyricsKerningType(toLyrics(item1), item2);
+        };
     case ElementType::NOTE:
-        return computeNoteKerningType(toNote(item1), item2);
+        return [](const EngravingItem* item1, const EngravingItem* item2) {
+            return computeNoteKerningType(toNote(item1), item2);
+        };
     case ElementType::STEM_SLASH:
-        return computeStemSlashKerningType(toStemSlash(item1), item2);
+        return [](const EngravingItem* item1, const EngravingItem* item2) {
+            return computeStemSlashKerningType(toStemSlash(item1), item2);
+        };
     default:
-        return KerningType::KERNING;
+        return nullptr;
     }
 }
 
+KerningType HorizontalSpacing::doComputeKerningType(const EngravingItem* item1, const EngravingItem* item2)
+{
+    KerningTypeRule rule = kerningTypeRule(item1->type());
+    return rule ? rule(item1, item2) : KerningType::KERNING;
+}
+
 KerningType HorizontalSpacing::computeNoteKerningType(const Note* note, const EngravingItem* item2)
 {
     EngravingItem* nextParent = item2->parentItem(true);
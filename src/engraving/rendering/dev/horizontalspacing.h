@@ -22,6 +22,8 @@
 #ifndef MU_ENGRAVING_HORIZONTALSPACINGUTILS_DEV_H
 #define MU_ENGRAVING_HORIZONTALSPACINGUTILS_DEV_H
 
+#include <cstddef>
+
 namespace mu::engraving {
 class Chord;
 class EngravingItem;
@@ -29,6 +31,7 @@ class Lyrics;
 class Note;
 class Rest;
 class Shape;
+struct ShapeElement;
 class StemSlash;
 class Segment;
 class Measure;
@@ -42,6 +45,8 @@ class HorizontalSpacing
 public:
 
     static double minHorizontalDistance(const Shape& f, const Shape& s, double spatium, double squeezeFactor = 1.0);
+    //! NOTE Checks all the pairs of elements, what minHorizontalDistance does for small shapes
+    static double minHorizontalDistancePairwise(const Shape& f, const Shape& s, double spatium, double squeezeFactor = 1.0);
     //! NOTE Temporary solution
     static double shapeSpatium(const Shape& s);
 
@@ -57,6 +62,15 @@ public:
     static double computeVerticalClearance(const EngravingItem* item1, const EngravingItem* item2, double spatium);
 
 private:
+    //! NOTE Below this number of element pairs the plain pairwise check is faster than indexing
+    static constexpr size_t Y_INDEX_MIN_PAIRS = 64;
+
+    static double minHorizontalDistanceIndexed(const Shape& f, const Shape& s, double spatium, double squeezeFactor);
+    static double shapeElementsDistance(const ShapeElement& r1, const ShapeElement& r2, double spatium, double squeezeFactor,
+                                        double absoluteMinPadding);
+    static bool isKernableLeft(const ShapeElement& r1);
+    static bool isKernableRight(const ShapeElement& r2);
+
     static bool isSpecialNotePaddingType(ElementType type);
     static void computeNotePadding(const Note* note, const EngravingItem* item2, double& padding, double scaling);
     static void computeLedgerRestPadding(const Rest* rest2, double& padding);
@@ -67,6 +81,8 @@ private:
     static bool isNeverKernable(const EngravingItem* item);
     static bool isAlwaysKernable(const EngravingItem* item);
 
+    using KerningTypeRule = KerningType (*)(const EngravingItem* item1, const EngravingItem* item2);
+    static KerningTypeRule kerningTypeRule(ElementType type1);
     static KerningType doComputeKerningType(const EngravingItem* item1, const EngravingItem* item2);
     static KerningType computeNoteKerningType(const Note* note, const EngravingItem* item2);
     static KerningType computeStemSlashKerningType(const StemSlash* stemSlash, const EngravingItem* item2);
@@ -469,6 +469,20 @@ void LayoutDebug::callPrint()
     LOGDA() << "\n" << callDump();
 }
 
+void LayoutDebug::cacheClear()
+{
+    m_cacheHits = 0;
+    m_cacheMisses = 0;
+}
+
+LayoutDebug::CacheStats LayoutDebug::cacheStats() const
+{
+    CacheStats stats;
+    stats.hits = m_cacheHits.load();
+    stats.misses = m_cacheMisses.load();
+    return stats;
+}
+
 // =============================================================
 // LayoutContext
 // =============================================================
@@ -22,8 +22,10 @@
 #ifndef MU_ENGRAVING_LAYOUTCONTEXT_DEV_H
 #define MU_ENGRAVING_LAYOUTCONTEXT_DEV_H
 
+#include <atomic>
 #include <vector>
 #include <set>
+#include <unordered_map>
 
 #include "../../types/fraction.h"
 #include "../../types/types.h"
@@ -55,6 +57,7 @@
 
 namespace mu::engraving {
 class EngravingItem;
+class Instrument;
 class RootItem;
 class MeasureBase;
 class Part;
@@ -103,6 +106,9 @@ public:
 
     bool isShowVBox() const { return options().isShowVBox; }
     double noteHeadWidth() const { return options().noteHeadWidth; }
+    bool isParallelLayout() const { return options().isParallelLayout; }
+    bool isMeasureLayoutCache() const { return options().isMeasureLayoutCache; }
+    size_t lazyLayoutPages() const { return options().lazyLayoutPages; }
     bool isShowInvisible() const;
     int pageNumberOffset() const;
     bool isVerticalSpreadEnabled() const;
@@ -273,6 +279,9 @@ public:
 
     std::set<Spanner*>& processedSpanners() { return m_processedSpanners; }
 
+    // content hashes of the instruments, computed once per layout pass
+    std::unordered_map<const Instrument*, uint64_t>& instrumentHashes() { return m_instrumentHashes; }
+
     void setRangeDone(bool val) { m_rangeDone = val; }
 
     void setTotalBracketsWidth(double val) { m_totalBracketsWidth = val; }
@@ -306,6 +315,8 @@ private:
 
     std::set<Spanner*> m_processedSpanners;
 
+    std::unordered_map<const Instrument*, uint64_t> m_instrumentHashes;
+
     bool m_rangeDone = false;
 
     double m_segmentShapeSqueezeFactor = 1.0;
@@ -357,6 +368,17 @@ public:
 
     void callPrint();
 
+    // Measure layout cache
+    struct CacheStats {
+        size_t hits = 0;
+        size_t misses = 0;
+    };
+
+    void cacheHit() { ++m_cacheHits; }
+    void cacheMiss() { ++m_cacheMisses; }
+    void cacheClear();
+    CacheStats cacheStats() const;
+
 private:
 
     struct Call {
@@ -370,6 +392,9 @@ private:
 
     Call* m_currentCall;
     std::vector<Call> m_calls;
+
+    std::atomic<size_t> m_cacheHits = 0;
+    std::atomic<size_t> m_cacheMisses = 0;
 };
 
 class LayoutContext : public IGetScoreInternal
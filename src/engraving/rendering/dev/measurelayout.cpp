@@ -25,10 +25,15 @@
 
 #include "infrastructure/rtti.h"
 
+#include "dom/accidental.h"
 #include "dom/ambitus.h"
+#include "dom/articulation.h"
 #include "dom/barline.h"
 #include "dom/beam.h"
+#include "dom/chord.h"
+#include "dom/drumset.h"
 #include "dom/factory.h"
+#include "dom/instrument.h"
 #include "dom/keysig.h"
 #include "dom/layoutbreak.h"
 #include "dom/lyrics.h"
@@ -38,11 +43,15 @@
 #include "dom/measurerepeat.h"
 #include "dom/mmrest.h"
 #include "dom/mmrestrange.h"
+#include "dom/note.h"
 #include "dom/ornament.h"
 #include "dom/part.h"
 #include "dom/spacer.h"
 #include "dom/score.h"
+#include "dom/staff.h"
 #include "dom/stafflines.h"
+#include "dom/stafftype.h"
+#include "dom/symbol.h"
 #include "dom/system.h"
 #include "dom/tie.h"
 #include "dom/timesig.h"
@@ -826,50 +835,268 @@ void MeasureLayout::checkStaffMoveValidity(Measure* measure, const LayoutContext
     }
 }
 
-void MeasureLayout::layoutMeasure(MeasureBase* currentMB, LayoutContext& ctx)
+//---------------------------------------------------------
+//   contentHash
+//    Fingerprint of everything layoutMeasure() reads:
+//    the measure content and the staff context at its tick.
+//    What the layout itself derives from that input (automatic
+//    accidentals, generated items, the start repeat barlines,
+//    the segment durations) is left out, so the hash taken
+//    before the layout is still valid after it.
+//---------------------------------------------------------
+
+class HashBuilder
 {
-    IF_ASSERT_FAILED(currentMB == ctx.state().curMeasure()) {
-        return;
+public:
+    template<typename T>
+    void add(const T& v)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(&v);
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            m_hash = (m_hash ^ p[i]) * 1099511628211ULL;
+        }
     }
 
-    if (!currentMB) {
-        return;
+    void add(const Fraction& f)
+    {
+        add(f.numerator());
+        add(f.denominator());
     }
 
-    int measureNo = adjustMeasureNo(currentMB, ctx.state().measureNo());
-    LAYOUT_CALL() << LAYOUT_ITEM_INFO(currentMB) << " measureNo: " << measureNo;
+    void add(const String& str)
+    {
+        add(str.size());
+        for (size_t i = 0; i < str.size(); ++i) {
+            add(str.at(i).unicode());
+        }
+    }
 
-    ctx.mutState().setMeasureNo(measureNo);
+    void add(const PointF& p)
+    {
+        add(p.x());
+        add(p.y());
+    }
 
-    createMultiMeasureRestsIfNeed(currentMB, ctx);
+    // the pointer alone may be reused by a new item after the old one is deleted
+    template<typename T>
+    void add(const T* item)
+    {
+        static_assert(std::is_base_of_v<EngravingObject, T>);
+        add(reinterpret_cast<uintptr_t>(item));
+        add(item->eid().toUint64());
+    }
 
-    currentMB = ctx.mutState().curMeasure();
+    uint64_t hash() const
+    {
+        // zero is reserved for "no hash"
+        return m_hash ? m_hash : 1;
+    }
 
-    if (!currentMB->isMeasure()) {
-        currentMB->setTick(ctx.state().tick());
+private:
+    uint64_t m_hash = 14695981039346656037ULL;
+};
+
+static void addItemToHash(const EngravingItem* item, HashBuilder& hb)
+{
+    hb.add(item);
+    hb.add(item->type());
+    hb.add(item->track());
+    hb.add(item->subtype());
+    hb.add(item->visible());
+    hb.add(item->placement());
+    hb.add(item->offset());
+    hb.add(item->autoplace());
+
+    if (item->isTextBase()) {
+        hb.add(toTextBase(item)->xmlText());
+    } else if (item->isSymbol()) {
+        hb.add(toSymbol(item)->sym());
+    }
+}
+
+static void addChordRestToHash(const ChordRest* cr, HashBuilder& hb)
+{
+    hb.add(cr->ticks());
+    hb.add(cr->durationType().type());
+    hb.add(cr->dots());
+    hb.add(cr->beamMode());
+    hb.add(cr->staffMove());
+    hb.add(cr->isSmall());
+    hb.add(cr->visible());
+    hb.add(cr->lyrics().size());
+    for (const Lyrics* lyrics : cr->lyrics()) {
+        addItemToHash(lyrics, hb);
+        hb.add(lyrics->no());
+        hb.add(lyrics->syllabic());
+    }
+
+    if (!cr->isChord()) {
         return;
     }
 
-    //-----------------------------------------
-    //    process one measure
-    //-----------------------------------------
+    const Chord* chord = toChord(cr);
+    hb.add(chord->stemDirection());
+    hb.add(chord->noStem());
+    hb.add(chord->articulations().size());
+    for (const Articulation* articulation : chord->articulations()) {
+        addItemToHash(articulation, hb);
+        hb.add(articulation->symId());
+        hb.add(articulation->direction());
+        hb.add(articulation->anchor());
+    }
+    hb.add(chord->graceNotes().size());
+    for (const Chord* grace : chord->graceNotes()) {
+        addChordRestToHash(grace, hb);
+    }
+    for (const Note* note : chord->notes()) {
+        hb.add(note);
+        hb.add(note->pitch());
+        hb.add(note->tpc1());
+        hb.add(note->tpc2());
+        hb.add(note->headGroup());
+        hb.add(note->headType());
+        hb.add(note->userMirror());
+        hb.add(note->fixed());
+        hb.add(note->fixedLine());
+        hb.add(note->string());
+        hb.add(note->fret());
+        hb.add(note->ghost());
+        hb.add(note->visible());
+        hb.add(note->tieBack() != nullptr);
+        const Accidental* accidental = note->accidental();
+        const bool isUserAccidental = accidental && accidental->role() == AccidentalRole::USER;
+        hb.add(isUserAccidental ? accidental->accidentalType() : AccidentalType::NONE);
+    }
+}
 
-    Measure* measure = toMeasure(currentMB);
+static void addStaffTypeToHash(const StaffType* staffType, HashBuilder& hb)
+{
+    hb.add(staffType->group());
+    hb.add(staffType->lines());
+    hb.add(staffType->stepOffset());
+    hb.add(staffType->lineDistance().val());
+    hb.add(staffType->userMag());
+    hb.add(staffType->isSmall());
+    hb.add(staffType->invisible());
+    hb.add(staffType->yoffset().val());
+    hb.add(staffType->stemless());
+    hb.add(staffType->genClef());
+    hb.add(staffType->genKeysig());
+    hb.add(staffType->genTimesig());
+    hb.add(staffType->showLedgerLines());
+    hb.add(staffType->noteHeadScheme());
+
+    if (!staffType->isTabStaff()) {
+        return;
+    }
 
-    measure->moveTicks(ctx.state().tick() - measure->tick());
+    hb.add(staffType->durationFontSize());
+    hb.add(staffType->fretFontSize());
+    hb.add(staffType->genDurations());
+    hb.add(staffType->minimStyle());
+    hb.add(staffType->symRepeat());
+    hb.add(staffType->onLines());
+    hb.add(staffType->showRests());
+    hb.add(staffType->stemsDown());
+    hb.add(staffType->stemThrough());
+    hb.add(staffType->upsideDown());
+    hb.add(staffType->showTabFingering());
+    hb.add(staffType->useNumbers());
+    hb.add(staffType->showBackTied());
+}
 
-    if (ctx.conf().isLinearMode() && (measure->tick() < ctx.state().startTick() || measure->tick() > ctx.state().endTick())) {
-        // needed to reset segment widths if they can change after measure width is computed
-        //for (Segment& s : measure->segments())
-        //      s.createShapes();
-        ctx.mutState().setTick(ctx.state().tick() + measure->ticks());
+static void addInstrumentToHash(const Instrument* instrument, HashBuilder& hb)
+{
+    hb.add(instrument->id());
+    hb.add(instrument->transpose().chromatic);
+    hb.add(instrument->transpose().diatonic);
+
+    for (const instrString& string : instrument->stringData()->stringList()) {
+        hb.add(string.pitch);
+        hb.add(string.open);
+        hb.add(string.startFret);
+    }
+
+    hb.add(instrument->useDrumset());
+    const Drumset* drumset = instrument->drumset();
+    if (!instrument->useDrumset() || !drumset) {
         return;
     }
 
-    // Check if requested cross-staff is possible
-    // This must happen before cmdUpdateNotes
-    checkStaffMoveValidity(measure, ctx);
+    for (int pitch = 0; pitch < DRUM_INSTRUMENTS; ++pitch) {
+        hb.add(drumset->isValid(pitch));
+        hb.add(drumset->noteHead(pitch));
+        hb.add(drumset->line(pitch));
+        hb.add(drumset->stemDirection(pitch));
+    }
+}
+
+static uint64_t instrumentHash(const Instrument* instrument, LayoutContext& ctx)
+{
+    std::unordered_map<const Instrument*, uint64_t>& hashes = ctx.mutState().instrumentHashes();
+    auto it = hashes.find(instrument);
+    if (it != hashes.end()) {
+        return it->second;
+    }
+
+    HashBuilder hb;
+    addInstrumentToHash(instrument, hb);
+    hashes.emplace(instrument, hb.hash());
+    return hb.hash();
+}
+
+uint64_t MeasureLayout::contentHash(const Measure* measure, LayoutContext& ctx)
+{
+    HashBuilder hb;
 
+    const Fraction tick = measure->tick();
+    hb.add(measure);
+    hb.add(tick);
+    hb.add(measure->ticks());
+    hb.add(measure->mmRestCount());
+    hb.add(measure->repeatStart());
+    hb.add(ctx.conf().style().revision());
+
+    hb.add(ctx.dom().nstaves());
+    for (const Staff* staff : ctx.dom().staves()) {
+        hb.add(staff->show());
+        addStaffTypeToHash(staff->staffType(tick), hb);
+        hb.add(staff->staffMag(tick));
+        hb.add(staff->key(tick));
+        hb.add(staff->clef(tick));
+        hb.add(instrumentHash(staff->part()->instrument(tick), ctx));
+    }
+
+    for (const Segment& segment : measure->segments()) {
+        if (segment.isStartRepeatBarLineType()) {
+            continue;
+        }
+        hb.add(&segment);
+        hb.add(segment.segmentType());
+        hb.add(segment.rtick());
+        hb.add(segment.enabled());
+        hb.add(segment.annotations().size());
+        for (const EngravingItem* e : segment.annotations()) {
+            addItemToHash(e, hb);
+        }
+        for (const EngravingItem* e : segment.elist()) {
+            if (!e || e->generated()) {
+                hb.add(ElementType::INVALID);
+                continue;
+            }
+            addItemToHash(e, hb);
+            if (e->isChordRest()) {
+                addChordRestToHash(toChordRest(e), hb);
+            }
+        }
+    }
+
+    return hb.hash();
+}
+
+void MeasureLayout::layoutMeasureChords(Measure* measure, LayoutContext& ctx)
+{
     // ---- Modify DOM ----
     ModifyDom::connectTremolo(measure);
     ModifyDom::cmdUpdateNotes(measure, ctx.dom());
@@ -911,21 +1138,10 @@ void MeasureLayout::layoutMeasure(MeasureBase* currentMB, LayoutContext& ctx)
             SegmentLayout::layoutChordsStem(segment, startTrack, endTrack, ctx);
         }
     }
+}
 
-    BeamLayout::createBeams(ctx, measure);
-
-    /* HACK: The real beam layout is computed at much later stage (you can't do the beams until you know
-     * horizontal spacing). However, horizontal spacing needs to know stems extensions to avoid collision
-     * with stems, and stems extensions depend on beams. Solution: we compute dummy beams here, *before*
-     * horizontal spacing. It is pointless for the beams themselves, but it *does* correctly extend the
-     * stems, thus allowing to compute horizontal spacing correctly. (M.S.) */
-    for (Segment& s : measure->segments()) {
-        if (!s.isChordRestType()) {
-            continue;
-        }
-        BeamLayout::layoutNonCrossBeams(&s, ctx);
-    }
-
+void MeasureLayout::layoutMeasureLyricsAndSymbols(Measure* measure, LayoutContext& ctx)
+{
     for (staff_idx_t staffIdx = 0; staffIdx < ctx.dom().nstaves(); ++staffIdx) {
         const Staff* staff = ctx.dom().staff(staffIdx);
         if (!staff->show()) {
@@ -965,6 +1181,88 @@ void MeasureLayout::layoutMeasure(MeasureBase* currentMB, LayoutContext& ctx)
             }
         }
     }
+}
+
+void MeasureLayout::layoutMeasure(MeasureBase* currentMB, LayoutContext& ctx)
+{
+    IF_ASSERT_FAILED(currentMB == ctx.state().curMeasure()) {
+        return;
+    }
+
+    if (!currentMB) {
+        return;
+    }
+
+    int measureNo = adjustMeasureNo(currentMB, ctx.state().measureNo());
+    LAYOUT_CALL() << LAYOUT_ITEM_INFO(currentMB) << " measureNo: " << measureNo;
+
+    ctx.mutState().setMeasureNo(measureNo);
+
+    createMultiMeasureRestsIfNeed(currentMB, ctx);
+
+    currentMB = ctx.mutState().curMeasure();
+
+    if (!currentMB->isMeasure()) {
+        currentMB->setTick(ctx.state().tick());
+        return;
+    }
+
+    //-----------------------------------------
+    //    process one measure
+    //-----------------------------------------
+
+    Measure* measure = toMeasure(currentMB);
+
+    measure->moveTicks(ctx.state().tick() - measure->tick());
+
+    if (ctx.conf().isLinearMode() && (measure->tick() < ctx.state().startTick() || measure->tick() > ctx.state().endTick())) {
+        // needed to reset segment widths if they can change after measure width is computed
+        //for (Segment& s : measure->segments())
+        //      s.createShapes();
+        ctx.mutState().setTick(ctx.state().tick() + measure->ticks());
+        return;
+    }
+
+    // Check if requested cross-staff is possible
+    // This must happen before cmdUpdateNotes
+    checkStaffMoveValidity(measure, ctx);
+
+    //! NOTE On a cache hit the chords and lyrics of the measure are kept from its previous layout.
+    //! The beams (which may continue from the previous measure), the stem extension for spacing,
+    //! the repeat barlines and the shapes are redone anyway
+    uint64_t hash = 0;
+    bool isCached = false;
+    if (ctx.conf().isMeasureLayoutCache()) {
+        hash = contentHash(measure, ctx);
+        isCached = hash == measure->ldata()->contentHash;
+        if (isCached) {
+            LayoutDebug::instance()->cacheHit();
+        } else {
+            LayoutDebug::instance()->cacheMiss();
+        }
+    }
+
+    if (!isCached) {
+        layoutMeasureChords(measure, ctx);
+    }
+
+    BeamLayout::createBeams(ctx, measure);
+
+    /* HACK: The real beam layout is computed at much later stage (you can't do the beams until you know
+     * horizontal spacing). However, horizontal spacing needs to know stems extensions to avoid collision
+     * with stems, and stems extensions depend on beams. Solution: we compute dummy beams here, *before*
+     * horizontal spacing. It is pointless for the beams themselves, but it *does* correctly extend the
+     * stems, thus allowing to compute horizontal spacing correctly. (M.S.) */
+    for (Segment& s : measure->segments()) {
+        if (!s.isChordRestType()) {
+            continue;
+        }
+        BeamLayout::layoutNonCrossBeams(&s, ctx);
+    }
+
+    if (!isCached) {
+        layoutMeasureLyricsAndSymbols(measure, ctx);
+    }
 
     Segment* seg = measure->findSegmentR(SegmentType::StartRepeatBarLine, Fraction(0, 1));
     if (measure->repeatStart()) {
@@ -995,6 +1293,10 @@ void MeasureLayout::layoutMeasure(MeasureBase* currentMB, LayoutContext& ctx)
     measure->computeTicks(); // Must be called *after* Segment::createShapes() because it relies on the
     // Segment::visible() property, which is determined by Segment::createShapes().
 
+    if (hash) {
+        measure->mutldata()->contentHash = hash;
+    }
+
     ctx.mutState().setTick(ctx.state().tick() + measure->ticks());
 }
 
@@ -85,6 +85,9 @@ private:
     static void moveToNextMeasure(LayoutContext& ctx);
     static void layoutMeasure(MeasureBase* currentMB, LayoutContext& ctx);
     static void checkStaffMoveValidity(Measure* measure, const LayoutContext& ctx);
+    static uint64_t contentHash(const Measure* measure, LayoutContext& ctx);
+    static void layoutMeasureChords(Measure* measure, LayoutContext& ctx);
+    static void layoutMeasureLyricsAndSymbols(Measure* measure, LayoutContext& ctx);
 
     static void createMultiMeasureRestsIfNeed(MeasureBase* currentMB, LayoutContext& ctx);
 };
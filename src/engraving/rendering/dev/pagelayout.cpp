@@ -94,6 +94,7 @@ void PageLayout::getNextPage(LayoutContext& ctx)
     }
     state.page()->mutldata()->setBbox(0.0, 0.0, ctx.conf().loWidth(), ctx.conf().loHeight());
     state.page()->setNo(state.pageIdx());
+    state.page()->setProvisional(false);
     double x = 0.0;
     double y = 0.0;
     if (state.pageIdx()) {
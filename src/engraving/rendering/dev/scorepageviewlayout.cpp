@@ -26,8 +26,10 @@
 #include "dom/score.h"
 #include "dom/system.h"
 #include "dom/bracket.h"
+#include "dom/factory.h"
 #include "dom/layoutbreak.h"
 #include "dom/page.h"
+#include "dom/staff.h"
 
 #include "passresetlayoutdata.h"
 #include "passlayoutindependentitems.h"
@@ -76,8 +78,19 @@ void ScorePageViewLayout::initLayoutContext(const Score* score, LayoutContext& c
         }
     }
 
-    if (!state.isLayoutAll() && m->system()) {
-        System* system = m->system();
+    System* system = m->system();
+    if (system && system->isProvisional()) {
+        // not laid out yet by a lazy layout, which continues after its last laid out system
+        system = nullptr;
+        for (System* s : score->systems()) {
+            if (s->isProvisional()) {
+                break;
+            }
+            system = s;
+        }
+    }
+
+    if (!state.isLayoutAll() && system) {
         system_idx_t systemIndex = muse::indexOf(score->systems(), system);
 
         // set current system
@@ -203,6 +216,7 @@ void ScorePageViewLayout::doLayout(LayoutContext& ctx)
     MeasureLayout::getNextMeasure(ctx);
     state.setCurSystem(SystemLayout::collectSystem(ctx));
 
+    const page_idx_t startPageIdx = state.pageIdx();
     const MeasureBase* lmb = nullptr;
     do {
         PageLayout::getNextPage(ctx);
@@ -223,16 +237,45 @@ void ScorePageViewLayout::doLayout(LayoutContext& ctx)
         //    c) this page ends with the same measure as the previous layout
         //    pageOldMeasure will be last measure from previous layout if range was completed on or before this page
         //    it will be nullptr if this page was never laid out or if we collected a system for next page
-    } while (state.curSystem() && !(state.rangeDone() && lmb == state.pageOldMeasure()));
+        // or
+        // 3) in the lazy mode, enough pages after the range are laid out, the rest stays provisional
+    } while (state.curSystem() && !(state.rangeDone() && lmb == state.pageOldMeasure())
+             && !isLazyLayoutDone(ctx, startPageIdx, lmb));
     // && page->system(0)->measures().back()->tick() > endTick // FIXME: perhaps the first measure was meant? Or last system?
 }
 
+bool ScorePageViewLayout::isLazyLayoutDone(const LayoutContext& ctx, page_idx_t startPageIdx, const MeasureBase* lastMeasure)
+{
+    const size_t lazyPages = ctx.conf().lazyLayoutPages();
+    if (lazyPages == 0 || !lastMeasure) {
+        return false;
+    }
+
+    // once the range is done the following systems are taken unchanged, so the rest is cheap
+    if (ctx.state().rangeDone()) {
+        return false;
+    }
+
+    // the edited range itself is always laid out
+    if (lastMeasure->endTick() <= ctx.state().endTick()) {
+        return false;
+    }
+
+    return ctx.state().pageIdx() - startPageIdx >= lazyPages;
+}
+
 void ScorePageViewLayout::layoutFinished(Score* score, LayoutContext& ctx)
 {
     LAYOUT_CALL();
 
     LayoutState& state = ctx.mutState();
 
+    if (state.curSystem() && !state.rangeDone()) {
+        // the layout was stopped by the lazy mode
+        keepProvisionalPages(score, ctx);
+        return;
+    }
+
     if (!state.curSystem()) {
         // The end of the score. The remaining systems are not needed...
         muse::DeleteAll(state.systemList());
@@ -252,4 +295,127 @@ void ScorePageViewLayout::layoutFinished(Score* score, LayoutContext& ctx)
     }
 
     score->systems().insert(score->systems().end(), state.systemList().begin(), state.systemList().end());
+
+    // the layout has caught up with the previous one, so the following pages are final,
+    // unless some of their measures still wait on a placeholder system
+    bool complete = true;
+    for (System* system : score->systems()) {
+        if (system->isProvisional()) {
+            system->page()->setProvisional(true);
+            complete = false;
+        }
+    }
+
+    if (complete) {
+        for (Page* page : score->pages()) {
+            page->setProvisional(false);
+        }
+    } else {
+        score->pages().back()->setProvisional(true);
+    }
+}
+
+void ScorePageViewLayout::keepProvisionalPages(Score* score, LayoutContext& ctx)
+{
+    LAYOUT_CALL();
+
+    LayoutState& state = ctx.mutState();
+    const page_idx_t firstProvisionalIdx = state.pageIdx();
+
+    // The system collected for the next page is dropped, it will be collected again
+    System* nextSystem = state.curSystem();
+    muse::remove(score->systems(), nextSystem);
+    state.setCurSystem(nullptr);
+
+    std::vector<System*> dropped = { nextSystem };
+    std::set<const System*> kept;
+
+    // The remaining systems of the previous layout are kept as they were, if they are on the following pages
+    // and none of their measures was taken by the new systems
+    for (System* system : state.systemList()) {
+        const page_idx_t pageIdx = system->page() ? score->pageIdx(system->page()) : muse::nidx;
+        bool keep = pageIdx != muse::nidx && pageIdx >= firstProvisionalIdx && !system->measures().empty()
+                    && !system->isProvisional();
+        for (const MeasureBase* mb : system->measures()) {
+            if (!keep) {
+                break;
+            }
+            keep = mb->system() == system;
+        }
+
+        if (keep) {
+            kept.insert(system);
+            score->systems().push_back(system);
+        } else {
+            dropped.push_back(system);
+        }
+    }
+    state.systemList().clear();
+
+    for (page_idx_t i = firstProvisionalIdx; i < score->npages(); ++i) {
+        Page* page = score->pages().at(i);
+        muse::remove_if(page->systems(), [&kept](const System* s) { return !muse::contains(kept, s); });
+        page->setProvisional(true);
+        page->invalidateBspTree();
+    }
+
+    // The measures between the laid out part and the kept systems stay on placeholder systems until they are laid out
+    const Fraction laidOutEndTick = state.page()->systems().empty() ? Fraction(0, 1) : state.page()->systems().back()->endTick();
+
+    // Keep at least one provisional page, so that the layout is known to be incomplete
+    if (firstProvisionalIdx >= score->npages()) {
+        PageLayout::getNextPage(ctx);
+        state.page()->setProvisional(true);
+    }
+
+    const bool showMMRests = score->style().styleB(Sid::createMultiMeasureRests);
+    const size_t nstaves = score->nstaves();
+    System* placeholder = nullptr;
+    std::vector<System*> placeholders;
+
+    for (MeasureBase* mb = score->first(); mb; mb = mb->next()) {
+        if (mb->tick() < laidOutEndTick) {
+            continue;
+        }
+
+        MeasureBase* mmRest = mb->isMeasure() ? toMeasure(mb)->mmRest() : nullptr;
+        MeasureBase* shown = mmRest && showMMRests ? mmRest : mb;
+        if (muse::contains(kept, static_cast<const System*>(shown->explicitParent()))) {
+            placeholder = nullptr;
+            continue;
+        }
+
+        if (!placeholder) {
+            placeholder = Factory::createSystem(score->pages().back());
+            placeholder->setProvisional(true);
+            placeholder->adjustStavesNumber(nstaves);
+            for (staff_idx_t i = 0; i < nstaves; ++i) {
+                placeholder->staff(i)->setShow(score->staff(i)->show());
+            }
+            placeholders.push_back(placeholder);
+        }
+
+        if (shown->explicitParent() != placeholder) {
+            placeholder->appendMeasure(shown);
+        }
+        for (MeasureBase* m : { mb, mmRest }) {
+            if (m) {
+                m->setParent(placeholder);
+            }
+        }
+    }
+
+    // Each placeholder goes on the page of the kept system that follows it, in tick order in the system list
+    for (System* p : placeholders) {
+        const Fraction tick = p->measures().front()->tick();
+        auto next = std::find_if(score->systems().begin(), score->systems().end(), [tick](const System* s) {
+            return !s->measures().empty() && s->measures().front()->tick() > tick;
+        });
+        if (next != score->systems().end()) {
+            p->setParent((*next)->page());
+        }
+        score->systems().insert(next, p);
+    }
+
+    muse::DeleteAll(dropped);
 }
@@ -38,7 +38,10 @@ private:
 
     static void doLayout(LayoutContext& ctx);
 
+    static bool isLazyLayoutDone(const LayoutContext& ctx, page_idx_t startPageIdx, const MeasureBase* lastMeasure);
+
     static void layoutFinished(Score* score, LayoutContext& ctx);
+    static void keepProvisionalPages(Score* score, LayoutContext& ctx);
 };
 }
 
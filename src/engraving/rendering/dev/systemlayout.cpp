@@ -19,12 +19,15 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
+#include <atomic>
 #include <cfloat>
+#include <thread>
 
 #include "systemlayout.h"
 
 #include "realfn.h"
 #include "defer.h"
+#include "concurrency/taskscheduler.h"
 
 #include "style/defaultstyle.h"
 
@@ -595,6 +598,7 @@ System* SystemLayout::getNextSystem(LayoutContext& ctx)
         system = muse::takeFirst(ctx.mutState().systemList());
         ctx.mutState().setSystemOldMeasure(system->measures().empty() ? 0 : system->measures().back());
         system->clear();       // remove measures from system
+        system->setProvisional(false);
     }
     ctx.mutDom().systems().push_back(system);
     if (!isVBox) {
@@ -728,6 +732,173 @@ void SystemLayout::hideEmptyStaves(System* system, LayoutContext& ctx, bool isFi
     }
 }
 
+static constexpr size_t PARALLEL_SKYLINE_MIN_STAVES = 4;
+
+//---------------------------------------------------------
+//   createSkylines
+//    Every staff skyline is built only from the elements of that staff
+//    and written only to its own SysStaff, so in parallel mode the staves
+//    are processed concurrently without changing the result.
+//---------------------------------------------------------
+
+void SystemLayout::createSkylines(System* system, LayoutContext& ctx)
+{
+    const size_t nstaves = ctx.dom().nstaves();
+
+#ifndef MUE_ENABLE_ENGRAVING_RENDER_DEBUG
+    if (ctx.conf().isParallelLayout() && nstaves >= PARALLEL_SKYLINE_MIN_STAVES) {
+        struct Jobs {
+            std::atomic<size_t> next = 0;
+            std::atomic<size_t> done = 0;
+        };
+
+        //! NOTE The jobs state is shared with the helper tasks, because a helper
+        //! may start only after all the work is done and the caller has returned
+        std::shared_ptr<Jobs> jobs = std::make_shared<Jobs>();
+        auto runJobs = [jobs, system, ctxPtr = &ctx, nstaves]() {
+            for (size_t staffIdx = jobs->next++; staffIdx < nstaves; staffIdx = jobs->next++) {
+                createSkyline(system, staffIdx, *ctxPtr);
+                ++jobs->done;
+            }
+        };
+
+        muse::TaskScheduler* scheduler = muse::TaskScheduler::instance();
+        const size_t helpers = std::min<size_t>(scheduler->threadPoolSize(), nstaves - 1);
+        for (size_t i = 0; i < helpers; ++i) {
+            scheduler->push(runJobs);
+        }
+
+        // the calling thread takes part in the work, so it never waits for a busy pool
+        runJobs();
+        while (jobs->done.load() < nstaves) {
+            std::this_thread::yield();
+        }
+        return;
+    }
+#endif
+
+    for (staff_idx_t staffIdx = 0; staffIdx < nstaves; ++staffIdx) {
+        createSkyline(system, staffIdx, ctx);
+    }
+}
+
+void SystemLayout::createSkyline(System* system, staff_idx_t staffIdx, LayoutContext& ctx)
+{
+    SysStaff* ss = system->staff(staffIdx);
+    Skyline& skyline = ss->skyline();
+    skyline.clear();
+    for (MeasureBase* mb : system->measures()) {
+        if (!mb->isMeasure()) {
+            continue;
+        }
+        Measure* m = toMeasure(mb);
+        MeasureNumber* mno = m->noText(staffIdx);
+        MMRestRange* mmrr  = m->mmRangeText(staffIdx);
+        // no need to build skyline outside of range in continuous view
+        if (ctx.conf().isLinearMode() && (m->tick() < ctx.state().startTick() || m->tick() > ctx.state().endTick())) {
+            continue;
+        }
+        if (mno && mno->addToSkyline()) {
+            ss->skyline().add(mno->ldata()->bbox().translated(m->pos() + mno->pos() + mno->staffOffset()), mno);
+        }
+        if (mmrr && mmrr->addToSkyline()) {
+            ss->skyline().add(mmrr->ldata()->bbox().translated(m->pos() + mmrr->pos()), mmrr);
+        }
+        if (m->staffLines(staffIdx)->addToSkyline()) {
+            ss->skyline().add(m->staffLines(staffIdx)->ldata()->bbox().translated(m->pos()), m->staffLines(staffIdx));
+        }
+        for (Segment& s : m->segments()) {
+            if (!s.enabled()) {
+                continue;
+            }
+            PointF p(s.pos() + m->pos());
+            if (s.segmentType()
+                & (SegmentType::BarLine | SegmentType::EndBarLine | SegmentType::StartRepeatBarLine | SegmentType::BeginBarLine)) {
+                BarLine* bl = toBarLine(s.element(staffIdx * VOICES));
+                if (bl && bl->addToSkyline()) {
+                    RectF r = TLayout::layoutRect(bl, ctx);
+                    skyline.add(r.translated(bl->pos() + p + bl->staffOffset()), bl);
+                }
+            } else if (s.segmentType() & SegmentType::TimeSig) {
+                TimeSig* ts = toTimeSig(s.element(staffIdx * VOICES));
+                if (ts && ts->addToSkyline()) {
+                    skyline.add(ts->shape().translate(ts->pos() + p + ts->staffOffset()));
+                }
+            } else {
+                track_idx_t strack = staffIdx * VOICES;
+                track_idx_t etrack = strack + VOICES;
+                for (EngravingItem* e : s.elist()) {
+                    if (!e) {
+                        continue;
+                    }
+                    track_idx_t effectiveTrack = e->vStaffIdx() * VOICES + e->voice();
+                    if (effectiveTrack < strack || effectiveTrack >= etrack) {
+                        continue;
+                    }
+
+                    // add element to skyline
+                    if (e->addToSkyline()) {
+                        const PointF offset = e->staffOffset();
+                        skyline.add(e->shape().translate(e->pos() + p + offset));
+                        // add grace notes to skyline
+                        if (e->isChord()) {
+                            GraceNotesGroup& graceBefore = toChord(e)->graceNotesBefore();
+                            GraceNotesGroup& graceAfter = toChord(e)->graceNotesAfter();
+                            TLayout::layoutGraceNotesGroup2(&graceBefore, graceBefore.mutldata());
+                            TLayout::layoutGraceNotesGroup2(&graceAfter, graceAfter.mutldata());
+                            if (!graceBefore.empty()) {
+                                skyline.add(graceBefore.shape().translate(graceBefore.pos() + p + offset));
+                            }
+                            if (!graceAfter.empty()) {
+                                skyline.add(graceAfter.shape().translate(graceAfter.pos() + p + offset));
+                            }
+                        }
+                        // If present, add ornament cue note to skyline
+                        if (e->isChord()) {
+                            Ornament* ornament = toChord(e)->findOrnament();
+                            if (ornament) {
+                                Chord* cue = ornament->cueNoteChord();
+                                if (cue && cue->upNote()->visible()) {
+                                    skyline.add(cue->shape().translate(cue->pos() + p + cue->staffOffset()));
+                                }
+                            }
+                        }
+                    }
+
+                    // add tremolo to skyline
+                    if (e->isChord()) {
+                        Chord* ch = item_cast<Chord*>(e);
+                        if (ch->tremoloSingleChord()) {
+                            TremoloSingleChord* t = ch->tremoloSingleChord();
+                            if (t->addToSkyline()) {
+                                skyline.add(t->shape().translate(t->pos() + e->pos() + p));
+                            }
+                        } else if (ch->tremoloTwoChord()) {
+                            TremoloTwoChord* t = ch->tremoloTwoChord();
+                            Chord* c1 = t->chord1();
+                            Chord* c2 = t->chord2();
+                            if (c1 && !c1->staffMove() && c2 && !c2->staffMove()) {
+                                if (t->chord() == e && t->addToSkyline()) {
+                                    skyline.add(t->shape().translate(t->pos() + e->pos() + p));
+                                }
+                            }
+                        }
+                    }
+
+                    // add beams to skline
+                    if (e->isChordRest()) {
+                        ChordRest* cr = toChordRest(e);
+                        if (BeamLayout::isTopBeam(cr)) {
+                            Beam* b = cr->beam();
+                            b->addSkyline(skyline);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
 void SystemLayout::layoutSystemElements(System* system, LayoutContext& ctx)
 {
     if (ctx.dom().nstaves() == 0) {
@@ -795,121 +966,7 @@ void SystemLayout::layoutSystemElements(System* system, LayoutContext& ctx)
     //    create skylines
     //-------------------------------------------------------------
 
-    for (size_t staffIdx = 0; staffIdx < ctx.dom().nstaves(); ++staffIdx) {
-        SysStaff* ss = system->staff(staffIdx);
-        Skyline& skyline = ss->skyline();
-        skyline.clear();
-        for (MeasureBase* mb : system->measures()) {
-            if (!mb->isMeasure()) {
-                continue;
-            }
-            Measure* m = toMeasure(mb);
-            MeasureNumber* mno = m->noText(staffIdx);
-            MMRestRange* mmrr  = m->mmRangeText(staffIdx);
-            // no need to build skyline outside of range in continuous view
-            if (ctx.conf().isLinearMode() && (m->tick() < ctx.state().startTick() || m->tick() > ctx.state().endTick())) {
-                continue;
-            }
-            if (mno && mno->addToSkyline()) {
-                ss->skyline().add(mno->ldata()->bbox().translated(m->pos() + mno->pos() + mno->staffOffset()), mno);
-            }
-            if (mmrr && mmrr->addToSkyline()) {
-                ss->skyline().add(mmrr->ldata()->bbox().translated(m->pos() + mmrr->pos()), mmrr);
-            }
-            if (m->staffLines(staffIdx)->addToSkyline()) {
-                ss->skyline().add(m->staffLines(staffIdx)->ldata()->bbox().translated(m->pos()), m->staffLines(staffIdx));
-            }
-            for (Segment& s : m->segments()) {
-                if (!s.enabled()) {
-                    continue;
-                }
-                PointF p(s.pos() + m->pos());
-                if (s.segmentType()
-                    & (SegmentType::BarLine | SegmentType::EndBarLine | SegmentType::StartRepeatBarLine | SegmentType::BeginBarLine)) {
-                    BarLine* bl = toBarLine(s.element(staffIdx * VOICES));
-                    if (bl && bl->addToSkyline()) {
-                        RectF r = TLayout::layoutRect(bl, ctx);
-                        skyline.add(r.translated(bl->pos() + p + bl->staffOffset()), bl);
-                    }
-                } else if (s.segmentType() & SegmentType::TimeSig) {
-                    TimeSig* ts = toTimeSig(s.element(staffIdx * VOICES));
-                    if (ts && ts->addToSkyline()) {
-                        skyline.add(ts->shape().translate(ts->pos() + p + ts->staffOffset()));
-                    }
-                } else {
-                    track_idx_t strack = staffIdx * VOICES;
-                    track_idx_t etrack = strack + VOICES;
-                    for (EngravingItem* e : s.elist()) {
-                        if (!e) {
-                            continue;
-                        }
-                        track_idx_t effectiveTrack = e->vStaffIdx() * VOICES + e->voice();
-                        if (effectiveTrack < strack || effectiveTrack >= etrack) {
-                            continue;
-                        }
-
-                        // add element to skyline
-                        if (e->addToSkyline()) {
-                            const PointF offset = e->staffOffset();
-                            skyline.add(e->shape().translate(e->pos() + p + offset));
-                            // add grace notes to skyline
-                            if (e->isChord()) {
-                                GraceNotesGroup& graceBefore = toChord(e)->graceNotesBefore();
-                                GraceNotesGroup& graceAfter = toChord(e)->graceNotesAfter();
-                                TLayout::layoutGraceNotesGroup2(&graceBefore, graceBefore.mutldata());
-                                TLayout::layoutGraceNotesGroup2(&graceAfter, graceAfter.mutldata());
-                                if (!graceBefore.empty()) {
-                                    skyline.add(graceBefore.shape().translate(graceBefore.pos() + p + offset));
-                                }
-                                if (!graceAfter.empty()) {
-                                    skyline.add(graceAfter.shape().translate(graceAfter.pos() + p + offset));
-                                }
-                            }
-                            // If present, add ornament cue note to skyline
-                            if (e->isChord()) {
-                                Ornament* ornament = toChord(e)->findOrnament();
-                                if (ornament) {
-                                    Chord* cue = ornament->cueNoteChord();
-                                    if (cue && cue->upNote()->visible()) {
-                                        skyline.add(cue->shape().translate(cue->pos() + p + cue->staffOffset()));
-                                    }
-                                }
-                            }
-                        }
-
-                        // add tremolo to skyline
-                        if (e->isChord()) {
-                            Chord* ch = item_cast<Chord*>(e);
-                            if (ch->tremoloSingleChord()) {
-                                TremoloSingleChord* t = ch->tremoloSingleChord();
-                                if (t->addToSkyline()) {
-                                    skyline.add(t->shape().translate(t->pos() + e->pos() + p));
-                                }
-                            } else if (ch->tremoloTwoChord()) {
-                                TremoloTwoChord* t = ch->tremoloTwoChord();
-                                Chord* c1 = t->chord1();
-                                Chord* c2 = t->chord2();
-                                if (c1 && !c1->staffMove() && c2 && !c2->staffMove()) {
-                                    if (t->chord() == e && t->addToSkyline()) {
-                                        skyline.add(t->shape().translate(t->pos() + e->pos() + p));
-                                    }
-                                }
-                            }
-                        }
-
-                        // add beams to skline
-                        if (e->isChordRest()) {
-                            ChordRest* cr = toChordRest(e);
-                            if (BeamLayout::isTopBeam(cr)) {
-                                Beam* b = cr->beam();
-                                b->addSkyline(skyline);
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
+    createSkylines(system, ctx);
 
     //-------------------------------------------------------------
     // layout ties and guitar bends
@@ -1380,7 +1437,7 @@ void SystemLayout::layoutSystemElements(System* system, LayoutContext& ctx)
     }
 }
 
-void SystemLayout::doLayoutTies(System* system, std::vector<Segment*> sl, const Fraction& stick, const Fraction& etick, LayoutContext& ctx)
+void SystemLayout::doLayoutTies(System* system, const std::vector<Segment*>& sl, const Fraction& stick, const Fraction& etick, LayoutContext& ctx)
 {
     UNUSED(etick);
 
@@ -1475,7 +1532,7 @@ void SystemLayout::layoutGuitarBends(const std::vector<Segment*>& sl, LayoutCont
     }
 }
 
-void SystemLayout::processLines(System* system, LayoutContext& ctx, std::vector<Spanner*> lines, bool align)
+void SystemLayout::processLines(System* system, LayoutContext& ctx, const std::vector<Spanner*>& lines, bool align)
 {
     std::vector<SpannerSegment*> segments;
     for (Spanner* sp : lines) {
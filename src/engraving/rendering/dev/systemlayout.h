@@ -65,9 +65,11 @@ public:
 
 private:
     static System* getNextSystem(LayoutContext& lc);
-    static void processLines(System* system, LayoutContext& ctx, std::vector<Spanner*> lines, bool align);
+    static void createSkylines(System* system, LayoutContext& ctx);
+    static void createSkyline(System* system, staff_idx_t staffIdx, LayoutContext& ctx);
+    static void processLines(System* system, LayoutContext& ctx, const std::vector<Spanner*>& lines, bool align);
     static void layoutTies(Chord* ch, System* system, const Fraction& stick, LayoutContext& ctx);
-    static void doLayoutTies(System* system, std::vector<Segment*> sl, const Fraction& stick, const Fraction& etick, LayoutContext& ctx);
+    static void doLayoutTies(System* system, const std::vector<Segment*>& sl, const Fraction& stick, const Fraction& etick, LayoutContext& ctx);
     static void doLayoutNoteSpannersLinear(System* system, LayoutContext& ctx);
     static void layoutNoteAnchoredSpanners(System* system, Chord* chord);
     static void layoutGuitarBends(const std::vector<Segment*>& sl, LayoutContext& ctx);
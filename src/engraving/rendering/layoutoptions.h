@@ -22,6 +22,8 @@
 #ifndef MU_ENGRAVING_LAYOUTOPTIONS_H
 #define MU_ENGRAVING_LAYOUTOPTIONS_H
 
+#include <cstddef>
+
 namespace mu::engraving {
 //---------------------------------------------------------
 //   LayoutMode
@@ -42,6 +44,19 @@ struct LayoutOptions
     bool isShowVBox = true;
     double noteHeadWidth = 0.0;
 
+    //! NOTE Lay out independent per-staff system data (skylines) on worker threads.
+    //! The result is the same as with serial layout, the option exists to compare both.
+    bool isParallelLayout = false;
+
+    //! NOTE Skip the per-measure chord/beam layout of measures outside the edited range
+    //! whose content fingerprint is unchanged since their last layout
+    bool isMeasureLayoutCache = false;
+
+    //! NOTE In the page view, stop the layout of an edit once the edited range is done
+    //! and this many pages are laid out; the following pages are kept from the previous
+    //! layout as provisional (see Score::layoutProvisionalPages). 0 - lay out all pages
+    size_t lazyLayoutPages = 0;
+
     bool isMode(LayoutMode m) const { return mode == m; }
     bool isLinearMode() const { return mode == LayoutMode::LINE || mode == LayoutMode::HORIZONTAL_FIXED; }
 };
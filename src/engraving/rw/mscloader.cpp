@@ -21,8 +21,11 @@
  */
 #include "mscloader.h"
 
+#include <atomic>
 #include <memory>
+#include <thread>
 
+#include "global/concurrency/taskscheduler.h"
 #include "global/io/buffer.h"
 #include "global/types/retval.h"
 
@@ -71,6 +74,75 @@ static RetVal<IReaderPtr> makeReader(int version, bool ignoreVersionError)
     return RetVal<IReaderPtr>::make_ok(RWRegister::reader(version));
 }
 
+static constexpr size_t PARALLEL_EXCERPTS_MIN_COUNT = 2;
+
+//---------------------------------------------------------
+//   excerptsBatchSize
+//    The parsed documents are much bigger than the files, so the
+//    excerpts are parsed in batches of one per thread, and the
+//    documents of a batch are freed once their DOM is built.
+//---------------------------------------------------------
+
+static size_t excerptsBatchSize()
+{
+    return std::max<size_t>(PARALLEL_EXCERPTS_MIN_COUNT, TaskScheduler::instance()->threadPoolSize() + 1);
+}
+
+//---------------------------------------------------------
+//   parseExcerpts
+//    Parsing the XML of an excerpt does not depend on the score,
+//    so the excerpts of a batch are parsed concurrently. The DOM
+//    is built from the parsed documents afterwards, in the file order.
+//---------------------------------------------------------
+
+static std::vector<std::unique_ptr<XmlReader> > parseExcerpts(const std::vector<ByteArray>& excerptsData)
+{
+    TRACEFUNC;
+
+    const size_t count = excerptsData.size();
+    std::vector<std::unique_ptr<XmlReader> > readers(count);
+
+    auto parse = [&excerptsData, &readers](size_t idx) {
+        readers[idx] = std::make_unique<XmlReader>(excerptsData[idx]);
+    };
+
+    if (count < PARALLEL_EXCERPTS_MIN_COUNT) {
+        for (size_t idx = 0; idx < count; ++idx) {
+            parse(idx);
+        }
+        return readers;
+    }
+
+    struct Jobs {
+        std::atomic<size_t> next = 0;
+        std::atomic<size_t> done = 0;
+    };
+
+    //! NOTE The jobs state is shared with the helper tasks, because a helper
+    //! may start only after all the work is done and the caller has returned
+    std::shared_ptr<Jobs> jobs = std::make_shared<Jobs>();
+    auto runJobs = [jobs, parse, count]() {
+        for (size_t idx = jobs->next++; idx < count; idx = jobs->next++) {
+            parse(idx);
+            ++jobs->done;
+        }
+    };
+
+    TaskScheduler* scheduler = TaskScheduler::instance();
+    const size_t helpers = std::min<size_t>(scheduler->threadPoolSize(), count - 1);
+    for (size_t i = 0; i < helpers; ++i) {
+        scheduler->push(runJobs);
+    }
+
+    // the calling thread takes part in the work, so it never waits for a busy pool
+    runJobs();
+    while (jobs->done.load() < count) {
+        std::this_thread::yield();
+    }
+
+    return readers;
+}
+
 Ret MscLoader::loadMscz(MasterScore* masterScore, const MscReader& mscReader, SettingsCompat& settingsCompat,
                         bool ignoreVersionError, rw::ReadInOutData* inOut)
 {
@@ -110,9 +182,18 @@ Ret MscLoader::loadMscz(MasterScore* masterScore, const MscReader& mscReader, Se
     // Read images
     {
         if (!MScore::noImages) {
+            //! NOTE A lazily loaded image keeps its data as it is stored in the container
+            //! and it is uncompressed on first use, the file is not read again
             std::vector<String> images = mscReader.imageFileNames();
             for (const String& name : images) {
-                imageStore.add(name, mscReader.readImageFile(name));
+                if (MScore::lazyLoadImages) {
+                    ZipReader::RawFileData raw = mscReader.readRawImageFile(name);
+                    imageStore.addLazy(name, [raw]() {
+                        return ZipReader::uncompressedData(raw);
+                    });
+                } else {
+                    imageStore.add(name, mscReader.readImageFile(name));
+                }
             }
         }
     }
@@ -140,55 +221,72 @@ Ret MscLoader::loadMscz(MasterScore* masterScore, const MscReader& mscReader, Se
     // Read excerpts
     if (ret && masterScore->mscVersion() >= 400) {
         std::vector<String> excerptFileNames = mscReader.excerptFileNames();
-        for (const String& excerptFileName : excerptFileNames) {
-            Score* partScore = masterScore->createScore();
+        const size_t batchSize = excerptsBatchSize();
 
-            compat::ReadStyleHook::setupDefaultStyle(partScore);
+        for (size_t batchStart = 0; ret && batchStart < excerptFileNames.size(); batchStart += batchSize) {
+            const size_t batchEnd = std::min(batchStart + batchSize, excerptFileNames.size());
 
-            Excerpt* ex = new Excerpt(masterScore);
-            ex->setExcerptScore(partScore);
-            ex->setFileName(excerptFileName);
+            std::vector<ByteArray> excerptsData;
+            excerptsData.reserve(batchEnd - batchStart);
+            for (size_t excerptIdx = batchStart; excerptIdx < batchEnd; ++excerptIdx) {
+                excerptsData.push_back(mscReader.readExcerptFile(excerptFileNames.at(excerptIdx)));
+            }
 
-            ByteArray excerptStyleData = mscReader.readExcerptStyleFile(excerptFileName);
-            Buffer excerptStyleBuf(&excerptStyleData);
-            excerptStyleBuf.open(IODevice::ReadOnly);
-            partScore->style().read(&excerptStyleBuf);
+            std::vector<std::unique_ptr<XmlReader> > excerptsXml = parseExcerpts(excerptsData);
+            excerptsData.clear();
 
-            ByteArray excerptData = mscReader.readExcerptFile(excerptFileName);
+            for (size_t excerptIdx = batchStart; excerptIdx < batchEnd; ++excerptIdx) {
+                const String& excerptFileName = excerptFileNames.at(excerptIdx);
+                Score* partScore = masterScore->createScore();
 
-            XmlReader xml(excerptData);
-            xml.setDocName(excerptFileName);
+                compat::ReadStyleHook::setupDefaultStyle(partScore);
 
-            ReadInOutData partReadInData;
-            partReadInData.links = inOut->links;
+                Excerpt* ex = new Excerpt(masterScore);
+                ex->setExcerptScore(partScore);
+                ex->setFileName(excerptFileName);
 
-            RetVal<IReaderPtr> reader = makeReader(masterScore->mscVersion(), ignoreVersionError);
-            if (!reader.ret) {
-                ret = reader.ret;
-                break;
-            }
+                ByteArray excerptStyleData = mscReader.readExcerptStyleFile(excerptFileName);
+                Buffer excerptStyleBuf(&excerptStyleData);
+                excerptStyleBuf.open(IODevice::ReadOnly);
+                partScore->style().read(&excerptStyleBuf);
 
-            Err err = reader.val->readScore(partScore, xml, &partReadInData);
-            ret =  make_ret(err);
-            if (!ret) {
-                break;
-            }
+                XmlReader& xml = *excerptsXml.at(excerptIdx - batchStart);
+                xml.setDocName(excerptFileName);
 
-            partScore->linkMeasures(masterScore);
+                ReadInOutData partReadInData;
+                partReadInData.links = inOut->links;
 
-            if (ex->name().empty()) {
-                // If no excerpt name tag was found while reading, try the "partName" meta tag
-                const String nameFromMeta = partScore->metaTag(u"partName");
+                RetVal<IReaderPtr> reader = makeReader(masterScore->mscVersion(), ignoreVersionError);
+                if (!reader.ret) {
+                    ret = reader.ret;
+                    break;
+                }
 
-                if (nameFromMeta.empty()) {
-                    // If that's also empty, fall back to the filename
-                    ex->setName(excerptFileName, /*saveAndNotify=*/ false);
-                } else {
-                    ex->setName(nameFromMeta, /*saveAndNotify=*/ false);
+                Err err = reader.val->readScore(partScore, xml, &partReadInData);
+                ret =  make_ret(err);
+                if (!ret) {
+                    break;
                 }
-            }
 
-            masterScore->addExcerpt(ex);
+                partScore->linkMeasures(masterScore);
+
+                if (ex->name().empty()) {
+                    // If no excerpt name tag was found while reading, try the "partName" meta tag
+                    const String nameFromMeta = partScore->metaTag(u"partName");
+
+                    if (nameFromMeta.empty()) {
+                        // If that's also empty, fall back to the filename
+                        ex->setName(excerptFileName, /*saveAndNotify=*/ false);
+                    } else {
+                        ex->setName(nameFromMeta, /*saveAndNotify=*/ false);
+                    }
+                }
+
+                masterScore->addExcerpt(ex);
+
+                // the document is not needed anymore
+                excerptsXml.at(excerptIdx - batchStart).reset();
+            }
         }
     }
 
@@ -21,12 +21,18 @@
  */
 #include "mscsaver.h"
 
+#include <atomic>
+#include <thread>
+
 #include "global/io/buffer.h"
+#include "global/serialization/json.h"
+#include "global/concurrency/taskscheduler.h"
 
 #include "dom/masterscore.h"
 #include "dom/excerpt.h"
 #include "dom/imageStore.h"
 #include "dom/audio.h"
+#include "dom/text.h"
 
 #include "rwregister.h"
 #include "inoutdata.h"
@@ -39,7 +45,116 @@ using namespace muse::io;
 using namespace mu::engraving;
 using namespace mu::engraving::rw;
 
-bool MscSaver::writeMscz(MasterScore* score, MscWriter& mscWriter, bool onlySelection, bool doCreateThumbnail)
+//! NOTE Just what listings of scores show (see MscMetaReader),
+//! so that they don't have to scan the score file
+static ByteArray scoreMetaJson(const MasterScore* score)
+{
+    auto frameText = [score](TextStyleType type) {
+        const Text* text = score->getText(type);
+        return text ? text->plainText() : String();
+    };
+
+    JsonObject metaTags;
+    for (const auto& tag : score->metaTags()) {
+        metaTags.set(tag.first.toStdString(), tag.second);
+    }
+
+    JsonObject root;
+    root.set("title", frameText(TextStyleType::TITLE));
+    root.set("subtitle", frameText(TextStyleType::SUBTITLE));
+    root.set("composer", frameText(TextStyleType::COMPOSER));
+    root.set("lyricist", frameText(TextStyleType::LYRICIST));
+    root.set("metaTags", metaTags);
+    root.set("partsCount", static_cast<int>(score->parts().size()));
+
+    return JsonDocument(root).toJson(JsonDocument::Format::Compact);
+}
+
+static bool hasPixmaps(const draw::DrawData::Item& item)
+{
+    for (const draw::DrawData::Data& data : item.datas) {
+        if (!data.pixmaps.empty()) {
+            return true;
+        }
+    }
+
+    for (const draw::DrawData::Item& child : item.chilren) {
+        if (hasPixmaps(child)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//! NOTE The thumbnail painting is recorded before the files are written,
+//! because writing may relayout the score (see Writer::write).
+//! Rendering it to a png, the costly part, runs meanwhile on the task scheduler.
+class ThumbnailJob
+{
+public:
+    ThumbnailJob(Score* score, const std::shared_ptr<draw::IImageProvider>& imageProvider)
+        : m_state(std::make_shared<State>())
+    {
+        m_state->data = score->paintThumbnail();
+        m_state->imageProvider = imageProvider;
+
+        //! NOTE Pixmaps are painted through a cache that can be used only on the main thread
+        if (!hasPixmaps(m_state->data->item)) {
+            std::shared_ptr<State> state = m_state;
+            TaskScheduler::instance()->push([state]() {
+                run(*state);
+            });
+        }
+    }
+
+    ~ThumbnailJob()
+    {
+        //! NOTE The task holds the state, it is skipped if it has not started yet
+        m_state->taken = true;
+    }
+
+    //! NOTE If the task has not started yet, the calling thread does it,
+    //! so it never waits for a busy pool
+    ByteArray result()
+    {
+        run(*m_state);
+        while (!m_state->done.load()) {
+            std::this_thread::yield();
+        }
+
+        return m_state->png;
+    }
+
+private:
+    struct State {
+        draw::DrawDataPtr data;
+        std::shared_ptr<draw::IImageProvider> imageProvider;
+        std::atomic<bool> taken = false;
+        std::atomic<bool> done = false;
+        ByteArray png;
+    };
+
+    static void run(State& state)
+    {
+        if (state.taken.exchange(true)) {
+            return;
+        }
+
+        auto pixmap = Score::renderThumbnail(state.data, state.imageProvider.get());
+
+        Buffer b(&state.png);
+        b.open(IODevice::WriteOnly);
+        state.imageProvider->saveAsPng(pixmap, &b);
+
+        state.done = true;
+    }
+
+    std::shared_ptr<State> m_state;
+};
+
+bool MscSaver::writeMscz(MasterScore* score, MscWriter& mscWriter, bool onlySelection, bool doCreateThumbnail,
+                         ExcerptsCache* excerptsCache)
 {
     TRACEFUNC;
 
@@ -47,6 +162,11 @@ bool MscSaver::writeMscz(MasterScore* score, MscWriter& mscWriter, bool onlySele
         return false;
     }
 
+    std::unique_ptr<ThumbnailJob> thumbnailJob;
+    if (doCreateThumbnail && !score->pages().empty()) {
+        thumbnailJob = std::make_unique<ThumbnailJob>(score, imageProvider());
+    }
+
     // Write style of MasterScore
     {
         //! NOTE The style is writing to a separate file only for the master score.
@@ -76,6 +196,9 @@ bool MscSaver::writeMscz(MasterScore* score, MscWriter& mscWriter, bool onlySele
         if (!onlySelection) {
             const std::vector<Excerpt*>& excerpts = score->excerpts();
 
+            ExcerptsCache::Entries newCacheEntries;
+            size_t reusedCount = 0;
+
             for (size_t excerptIndex = 0; excerptIndex < excerpts.size(); ++excerptIndex) {
                 Excerpt* excerpt = excerpts.at(excerptIndex);
 
@@ -86,6 +209,30 @@ bool MscSaver::writeMscz(MasterScore* score, MscWriter& mscWriter, bool onlySele
 
                 excerpt->updateFileName(excerptIndex);
 
+                //! NOTE The links of an excerpt are written relative to the master score,
+                //! and to the links written just before it, so both must be the same as the last time
+                write::WriteContext& ctx = masterWriteOutData.ctx;
+                if (excerptsCache) {
+                    auto it = excerptsCache->entries.find(partScore);
+                    if (it != excerptsCache->entries.end()) {
+                        const ExcerptsCache::Entry& entry = it->second;
+                        if (entry.revision == partScore->revision()
+                            && entry.isOpen == partScore->isOpen()
+                            && entry.linksIndexerBefore == ctx.linksIndexer()) {
+                            mscWriter.addExcerptStyleFile(excerpt->fileName(), entry.styleData);
+                            mscWriter.addExcerptFile(excerpt->fileName(), entry.data);
+                            ctx.setLinksIndexer(entry.linksIndexerAfter);
+
+                            newCacheEntries.emplace(partScore, entry);
+                            ++reusedCount;
+                            continue;
+                        }
+                    }
+                }
+
+                ExcerptsCache::Entry entry;
+                entry.linksIndexerBefore = ctx.linksIndexer();
+
                 // Write excerpt style
                 {
                     ByteArray excerptStyleData;
@@ -94,6 +241,7 @@ bool MscSaver::writeMscz(MasterScore* score, MscWriter& mscWriter, bool onlySele
                     partScore->style().write(&styleStyleBuf);
 
                     mscWriter.addExcerptStyleFile(excerpt->fileName(), excerptStyleData);
+                    entry.styleData = excerptStyleData;
                 }
 
                 // Write excerpt
@@ -106,11 +254,32 @@ bool MscSaver::writeMscz(MasterScore* score, MscWriter& mscWriter, bool onlySele
                         excerpt->excerptScore(), &excerptBuf, onlySelection, &masterWriteOutData);
 
                     mscWriter.addExcerptFile(excerpt->fileName(), excerptData);
+                    entry.data = excerptData;
                 }
+
+                if (excerptsCache) {
+                    //! NOTE Writing may touch the score (see Writer::write), so take the revision after it
+                    entry.revision = partScore->revision();
+                    entry.isOpen = partScore->isOpen();
+                    entry.linksIndexerAfter = ctx.linksIndexer();
+                    newCacheEntries.emplace(partScore, std::move(entry));
+                }
+            }
+
+            if (excerptsCache) {
+                LOGD() << "reused excerpts: " << reusedCount << " of " << excerpts.size();
+                excerptsCache->entries = std::move(newCacheEntries);
             }
         }
     }
 
+    // Write meta
+    {
+        if (!onlySelection) {
+            mscWriter.writeScoreMetaJsonFile(scoreMetaJson(score));
+        }
+    }
+
     // Write ChordList
     {
         ChordList* chordList = score->chordList();
@@ -136,14 +305,8 @@ bool MscSaver::writeMscz(MasterScore* score, MscWriter& mscWriter, bool onlySele
 
     // Write thumbnail
     {
-        if (doCreateThumbnail && !score->pages().empty()) {
-            auto pixmap = score->createThumbnail();
-
-            ByteArray ba;
-            Buffer b(&ba);
-            b.open(IODevice::WriteOnly);
-            imageProvider()->saveAsPng(pixmap, &b);
-            mscWriter.writeThumbnailFile(ba);
+        if (thumbnailJob) {
+            mscWriter.writeThumbnailFile(thumbnailJob->result());
         }
     }
 
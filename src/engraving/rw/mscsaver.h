@@ -22,11 +22,15 @@
 #ifndef MU_ENGRAVING_MSCSAVER_H
 #define MU_ENGRAVING_MSCSAVER_H
 
+#include <map>
+
 #include "global/modularity/ioc.h"
 #include "draw/iimageprovider.h"
 
 #include "../infrastructure/mscwriter.h"
 
+#include "linksindexer.h"
+
 namespace mu::engraving {
 class MasterScore;
 class Score;
@@ -37,7 +41,24 @@ public:
     MscSaver(const muse::modularity::ContextPtr& iocCtx)
         : muse::Injectable(iocCtx) {}
 
-    bool writeMscz(MasterScore* score, MscWriter& mscWriter, bool onlySelection, bool doCreateThumbnail);
+    //! NOTE Excerpts as serialized by the previous save.
+    //! The ones no command has touched since are written again as they are
+    struct ExcerptsCache {
+        struct Entry {
+            uint64_t revision = 0;
+            bool isOpen = false;
+            LinksIndexer linksIndexerBefore;
+            LinksIndexer linksIndexerAfter;
+            muse::ByteArray styleData;
+            muse::ByteArray data;
+        };
+
+        using Entries = std::map<const Score*, Entry>;
+        Entries entries;
+    };
+
+    bool writeMscz(MasterScore* score, MscWriter& mscWriter, bool onlySelection, bool doCreateThumbnail,
+                   ExcerptsCache* excerptsCache = nullptr);
 
     bool exportPart(Score* partScore, MscWriter& mscWriter);
 };
@@ -189,7 +189,7 @@ bool Read410::readScore410(Score* score, XmlReader& e, ReadContext& ctx)
             score->clearSystemObjectStaves();
             while (e.readNextStartElement()) {
                 if (e.name() == "Instance") {
-                    int staffIdx = e.attribute("staffId").toInt() - 1;
+                    int staffIdx = e.intAttribute("staffId") - 1;
                     // TODO: read the other attributes from this element when we begin treating different classes
                     // of system objects differently. ex:
                     // bool showBarNumbers = !(e.hasAttribute("barNumbers") && e.attribute("barNumbers") == "false");
@@ -372,7 +372,7 @@ PropertyValue TRead::readPropertyValue(Pid id, XmlReader& e, ReadContext& ctx)
         return PropertyValue(e.readText());
 
     case P_TYPE::ALIGN:
-        return PropertyValue(TConv::fromXml(e.readText(), Align()));
+        return PropertyValue(TConv::fromXml(e.readAsciiText(), Align()));
     case P_TYPE::PLACEMENT_V:
         return PropertyValue(TConv::fromXml(e.readAsciiText(), PlacementV::ABOVE));
     case P_TYPE::PLACEMENT_H:
@@ -452,7 +452,7 @@ PropertyValue TRead::readPropertyValue(Pid id, XmlReader& e, ReadContext& ctx)
 
 bool TRead::readProperty(EngravingItem* item, const AsciiStringView& tag, XmlReader& xml, ReadContext& ctx, Pid pid)
 {
-    if (tag == propertyName(pid)) {
+    if (tag == propertyNameView(pid)) {
         readProperty(item, xml, ctx, pid);
         return true;
     }
@@ -47,6 +47,9 @@ public:
     void setLidLocalIndex(int lid, int localIndex);
     int lidLocalIndex(int lid) const;
 
+    const LinksIndexer& linksIndexer() const { return m_linksIndexer; }
+    void setLinksIndexer(const LinksIndexer& indexer) { m_linksIndexer = indexer; }
+
     Fraction curTick() const { return _curTick; }
     void setCurTick(const Fraction& v) { _curTick   = v; }
     void incCurTick(const Fraction& v) { _curTick += v; }
@@ -22,6 +22,8 @@
 
 #include "xmlreader.h"
 
+#include <charconv>
+
 #include "log.h"
 
 using namespace mu;
@@ -107,6 +109,23 @@ RectF XmlReader::readRect()
     return p;
 }
 
+//---------------------------------------------------------
+//   parseIntFast
+//    parse a plain number straight from the bytes,
+//    returns false for anything else
+//---------------------------------------------------------
+
+static bool parseIntFast(const char* str, size_t size, int& v)
+{
+    int i = 0;
+    const std::from_chars_result r = std::from_chars(str, str + size, i);
+    if (r.ec != std::errc() || r.ptr != str + size) {
+        return false;
+    }
+    v = i;
+    return true;
+}
+
 //---------------------------------------------------------
 //   readFraction
 //    recognizes this two styles:
@@ -124,6 +143,8 @@ Fraction XmlReader::readFraction()
         size_t i = s.indexOf('/');
         if (i == muse::nidx) {
             return Fraction::fromTicks(s.toInt());
+        } else if (parseIntFast(s.ascii(), i, z) && parseIntFast(s.ascii() + i + 1, s.size() - i - 1, n)) {
+            return Fraction(z, n);
         } else {
             String str = String::fromAscii(s.ascii());
             z = str.left(i).toInt();
@@ -22,6 +22,8 @@
 
 #include "xmlwriter.h"
 
+#include <charconv>
+
 #include "types/typesconv.h"
 
 #include "dom/engravingitem.h"
@@ -321,7 +323,13 @@ void XmlWriter::tagFraction(const AsciiStringView& name, const Fraction& v, cons
         return;
     }
 
-    element(name, v.toString());
+    // the same as Fraction::toString, without the String
+    char buf[32];
+    char* end = buf + sizeof(buf);
+    char* p = std::to_chars(buf, end, v.numerator()).ptr;
+    *p++ = '/';
+    p = std::to_chars(p, end, v.denominator()).ptr;
+    element(name, AsciiStringView(buf, static_cast<size_t>(p - buf)));
 }
 
 void XmlWriter::writeXml(const String& name, String s)
@@ -22,6 +22,8 @@
 
 #include "style.h"
 
+#include <atomic>
+
 #include "types/constants.h"
 #include "compat/pageformat.h"
 #include "rw/compat/readchordlisthook.h"
@@ -73,6 +75,7 @@ void MStyle::set(const Sid t, const PropertyValue& val)
 
     const size_t idx = size_t(t);
     m_values[idx] = val;
+    m_revision = newRevision();
     if (t == Sid::spatium) {
         precomputeValues();
     } else {
@@ -83,6 +86,13 @@ void MStyle::set(const Sid t, const PropertyValue& val)
     }
 }
 
+uint64_t MStyle::newRevision()
+{
+    // global, so that two styles never share a revision unless one is a copy of the other
+    static std::atomic<uint64_t> lastRevision = 0;
+    return ++lastRevision;
+}
+
 void MStyle::precomputeValues()
 {
     double _spatium = value(Sid::spatium).toReal();
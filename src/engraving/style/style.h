@@ -70,6 +70,9 @@ public:
     void setSpatium(double v) { set(Sid::spatium, v); }
 
     bool isDefault(Sid idx) const;
+
+    // changes whenever a value is set, so that cached layout can tell if the style is still the same
+    uint64_t revision() const { return m_revision; }
     void setDefaultStyleVersion(const int defaultsVersion);
     int defaultStyleVersion() const;
 
@@ -97,6 +100,9 @@ private:
     std::array<PropertyValue, size_t(Sid::STYLES)> m_values;
     std::array<Millimetre, size_t(Sid::STYLES)> m_precomputedValues;
 
+    static uint64_t newRevision();
+    uint64_t m_revision = newRevision();
+
     void readVersion(String versionTag);
     int m_version = 0;
 };
@@ -0,0 +1,82 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+
+#include "io/dir.h"
+#include "io/file.h"
+#include "serialization/json.h"
+
+#include "layoutbenchmark.h"
+#include "syntheticscores.h"
+
+#include "log.h"
+
+using namespace muse;
+using namespace mu::engraving;
+
+static const char* OUTPUT_ENV = "ENGRAVING_LAYOUT_BENCH_OUTPUT";
+static const char* SCORES_ENV = "ENGRAVING_LAYOUT_BENCH_SCORES";
+static const char* DEFAULT_OUTPUT = "engraving_layout_bench.json";
+
+class Engraving_LayoutBenchmark : public ::testing::Test
+{
+public:
+    static io::path_t envPath(const char* name, const io::path_t& def)
+    {
+        const char* val = std::getenv(name);
+        return (val && val[0]) ? io::path_t(val) : def;
+    }
+};
+
+TEST_F(Engraving_LayoutBenchmark, run)
+{
+    LayoutBenchmark bench;
+    JsonArray results;
+
+    //! NOTE Synthetic giant scores
+    for (const SyntheticScores::Params& params : SyntheticScores::defaultParams()) {
+        const io::path_t path = io::path_t(params.name) + ".mscx";
+        ASSERT_TRUE(io::File::writeFile(path, SyntheticScores::generate(params)));
+
+        LayoutBenchmark::Result result = bench.run(params.name, path);
+        EXPECT_GT(result.pages, 0u) << params.name;
+        results.append(result.toJson());
+    }
+
+    //! NOTE The vtest corpus
+    const io::path_t scoresDir = envPath(SCORES_ENV, ENGRAVING_LAYOUT_BENCH_SCORES_DIR);
+    RetVal<io::paths_t> files = io::Dir::scanFiles(scoresDir, { "*.mscx", "*.mscz" }, io::ScanMode::FilesInCurrentDir);
+    if (!files.ret) {
+        LOGW() << "no scores in: " << scoresDir;
+    }
+
+    for (const io::path_t& file : files.val) {
+        LayoutBenchmark::Result result = bench.run(io::filename(file).toStdString(), file);
+        results.append(result.toJson());
+    }
+
+    const io::path_t output = envPath(OUTPUT_ENV, DEFAULT_OUTPUT);
+    EXPECT_TRUE(io::File::writeFile(output, JsonDocument(results).toJson()));
+    LOGI() << "results written to: " << output;
+}
@@ -0,0 +1,216 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "layoutbenchmark.h"
+
+#include <chrono>
+#include <limits>
+
+#include "draw/bufferedpaintprovider.h"
+#include "draw/painter.h"
+
+#include "dom/chord.h"
+#include "dom/excerpt.h"
+#include "dom/masterscore.h"
+#include "dom/measure.h"
+#include "dom/note.h"
+#include "dom/page.h"
+#include "dom/part.h"
+#include "dom/segment.h"
+
+#include "rendering/dev/scorerenderer.h"
+#include "rendering/stable/scorerenderer.h"
+
+#include "utils/scorerw.h"
+
+#include "log.h"
+
+using namespace muse;
+using namespace muse::draw;
+using namespace mu::engraving;
+
+LayoutBenchmark::LayoutBenchmark(int repeats)
+    : m_repeats(std::max(repeats, 1))
+{
+}
+
+JsonObject LayoutBenchmark::Result::toJson() const
+{
+    JsonObject obj;
+    obj.set("score", name);
+    obj.set("measures", static_cast<int>(measures));
+    obj.set("staves", static_cast<int>(staves));
+    obj.set("pages", static_cast<int>(pages));
+    obj.set("load", loadMs);
+
+    JsonObject phasesObj;
+    for (const Phase& p : phases) {
+        phasesObj.set(p.name, p.ms);
+    }
+    obj.set("phases", phasesObj);
+
+    return obj;
+}
+
+double LayoutBenchmark::measure(const std::function<void()>& func) const
+{
+    double best = std::numeric_limits<double>::max();
+    for (int i = 0; i < m_repeats; ++i) {
+        best = std::min(best, elapsed(func));
+    }
+    return best;
+}
+
+double LayoutBenchmark::elapsed(const std::function<void()>& func)
+{
+    using clock = std::chrono::steady_clock;
+
+    clock::time_point start = clock::now();
+    func();
+    std::chrono::duration<double, std::milli> ms = clock::now() - start;
+    return ms.count();
+}
+
+LayoutBenchmark::Result LayoutBenchmark::run(const std::string& name, const io::path_t& path) const
+{
+    Result result;
+    result.name = name;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    MasterScore* score = ScoreRW::readScore(path.toString(), true);
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    result.loadMs = elapsed.count();
+
+    if (!score) {
+        LOGE() << "failed to read score: " << path;
+        return result;
+    }
+
+    result.measures = score->nmeasures();
+    result.staves = score->nstaves();
+
+    benchFullLayout(score, result);
+    benchNoteRelayout(score, result);
+    benchPaint(score, result);
+    benchPartsLayout(score, result);
+
+    result.pages = score->npages();
+
+    delete score;
+
+    return result;
+}
+
+void LayoutBenchmark::benchFullLayout(MasterScore* score, Result& result) const
+{
+    const Fraction st = Fraction(0, 1);
+    const Fraction et = Fraction(-1, 1);
+
+    rendering::stable::ScoreRenderer stable;
+    result.phases.push_back({ "layout.stable", measure([&]() { stable.layoutScore(score, st, et); }) });
+
+    // the dev engine goes last, so the score stays laid out by it for the following phases
+    rendering::dev::ScoreRenderer dev;
+
+    score->setParallelLayout(true);
+    result.phases.push_back({ "layout.dev.parallel", measure([&]() { dev.layoutScore(score, st, et); }) });
+    score->setParallelLayout(false);
+
+    result.phases.push_back({ "layout.dev", measure([&]() { dev.layoutScore(score, st, et); }) });
+}
+
+void LayoutBenchmark::benchNoteRelayout(MasterScore* score, Result& result) const
+{
+    // the first note of the middle measure
+    Note* note = nullptr;
+    const size_t middle = score->nmeasures() / 2;
+    size_t idx = 0;
+    for (Measure* m = score->firstMeasure(); m && !note; m = m->nextMeasure(), ++idx) {
+        if (idx < middle) {
+            continue;
+        }
+        for (Segment* s = m->first(SegmentType::ChordRest); s && !note; s = s->next(SegmentType::ChordRest)) {
+            EngravingItem* e = s->element(0);
+            if (e && e->isChord()) {
+                note = toChord(e)->upNote();
+            }
+        }
+    }
+
+    if (!note) {
+        return;
+    }
+
+    const staff_idx_t staffIdx = note->staffIdx();
+
+    auto relayout = [score, note, staffIdx]() {
+        score->select(note, SelectType::SINGLE, staffIdx);
+        score->startCmd();
+        score->upDown(true, UpDownMode::CHROMATIC);
+        score->endCmd();
+    };
+
+    // one edit per run, each undone outside the measured time,
+    // so that every run (and the following phases) sees the original score
+    double best = std::numeric_limits<double>::max();
+    for (int i = 0; i < m_repeats; ++i) {
+        best = std::min(best, elapsed(relayout));
+        score->undoRedo(true, nullptr);
+    }
+
+    result.phases.push_back({ "relayout.note", best });
+}
+
+void LayoutBenchmark::benchPartsLayout(MasterScore* score, Result& result) const
+{
+    if (score->excerpts().empty()) {
+        std::vector<Excerpt*> excerpts = Excerpt::createExcerptsFromParts(score->parts(), score);
+        for (Excerpt* ex : excerpts) {
+            score->initAndAddExcerpt(ex, true);
+        }
+    }
+
+    result.phases.push_back({ "layout.parts", measure([score]() {
+            for (Excerpt* ex : score->excerpts()) {
+                if (Score* partScore = ex->excerptScore()) {
+                    partScore->doLayout();
+                }
+            }
+        }) });
+}
+
+void LayoutBenchmark::benchPaint(Score* score, Result& result) const
+{
+    rendering::dev::ScoreRenderer renderer;
+
+    rendering::IScoreRenderer::PaintOptions opt;
+    opt.isMultiPage = true;
+    opt.deviceDpi = 72.0;
+    opt.printPageBackground = true;
+    opt.isSetViewport = true;
+    opt.isPrinting = true;
+
+    result.phases.push_back({ "paint", measure([&]() {
+            auto pd = std::make_shared<BufferedPaintProvider>();
+            Painter painter(pd, "LayoutBenchmark");
+            renderer.paintScore(&painter, score, opt);
+        }) });
+}
@@ -0,0 +1,75 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_ENGRAVING_LAYOUTBENCHMARK_H
+#define MU_ENGRAVING_LAYOUTBENCHMARK_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "io/path.h"
+#include "serialization/json.h"
+
+namespace mu::engraving {
+class MasterScore;
+class Score;
+
+//! NOTE Measures the time of the layout phases of a score,
+//! every phase is repeated and the best time is taken
+class LayoutBenchmark
+{
+public:
+    LayoutBenchmark(int repeats = 3);
+
+    struct Phase {
+        std::string name;
+        double ms = 0.0;
+    };
+
+    struct Result {
+        std::string name;
+        size_t measures = 0;
+        size_t staves = 0;
+        size_t pages = 0;
+        double loadMs = 0.0;
+        std::vector<Phase> phases;
+
+        muse::JsonObject toJson() const;
+    };
+
+    Result run(const std::string& name, const muse::io::path_t& path) const;
+
+private:
+    // the best of m_repeats runs
+    double measure(const std::function<void()>& func) const;
+    static double elapsed(const std::function<void()>& func);
+
+    void benchFullLayout(MasterScore* score, Result& result) const;
+    void benchNoteRelayout(MasterScore* score, Result& result) const;
+    void benchPartsLayout(MasterScore* score, Result& result) const;
+    void benchPaint(Score* score, Result& result) const;
+
+    int m_repeats = 3;
+};
+}
+
+#endif // MU_ENGRAVING_LAYOUTBENCHMARK_H
@@ -0,0 +1,155 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+
+#include "io/buffer.h"
+#include "io/dir.h"
+#include "io/file.h"
+#include "serialization/json.h"
+
+#include "dom/masterscore.h"
+#include "infrastructure/mscwriter.h"
+#include "rw/mscsaver.h"
+#include "rw/rwregister.h"
+
+#include "utils/scorerw.h"
+
+#include "syntheticscores.h"
+
+#include "log.h"
+
+using namespace muse;
+using namespace muse::io;
+using namespace mu::engraving;
+
+static const char* OUTPUT_ENV = "ENGRAVING_SAVE_BENCH_OUTPUT";
+static const char* SCORES_ENV = "ENGRAVING_SAVE_BENCH_SCORES";
+static const char* DEFAULT_OUTPUT = "engraving_save_bench.json";
+
+static constexpr int REPEATS = 5;
+
+//! NOTE Measures writing a score to mscx and to mscz in memory,
+//! every save is repeated and the best time is taken
+class Engraving_SaveBenchmark : public ::testing::Test
+{
+public:
+    static path_t envPath(const char* name, const path_t& def)
+    {
+        const char* val = std::getenv(name);
+        return (val && val[0]) ? path_t(val) : def;
+    }
+
+    static double measure(const std::function<size_t()>& save, size_t& bytes)
+    {
+        using clock = std::chrono::steady_clock;
+
+        double best = std::numeric_limits<double>::max();
+        for (int i = 0; i < REPEATS; ++i) {
+            clock::time_point start = clock::now();
+            bytes = save();
+            std::chrono::duration<double, std::milli> elapsed = clock::now() - start;
+            best = std::min(best, elapsed.count());
+        }
+        return best;
+    }
+
+    static JsonObject run(const std::string& name, const path_t& path)
+    {
+        JsonObject obj;
+        obj.set("score", name);
+
+        MasterScore* score = ScoreRW::readScore(path.toString(), true);
+        if (!score) {
+            LOGE() << "failed to read score: " << path;
+            return obj;
+        }
+
+        size_t mscxBytes = 0;
+        const double mscxMs = measure([score]() {
+            ByteArray data;
+            Buffer buf(&data);
+            buf.open(IODevice::WriteOnly);
+            rw::RWRegister::writer(score->iocContext())->writeScore(score, &buf, false);
+            return data.size();
+        }, mscxBytes);
+
+        size_t msczBytes = 0;
+        const double msczMs = measure([score]() {
+            ByteArray data;
+            {
+                Buffer buf(&data);
+                MscWriter::Params params;
+                params.device = &buf;
+                params.filePath = u"savebench.mscz";
+                params.mode = MscIoMode::Zip;
+
+                MscWriter writer(params);
+                writer.open();
+                MscSaver(score->iocContext()).writeMscz(score, writer, false, false);
+            }
+            return data.size();
+        }, msczBytes);
+
+        obj.set("measures", static_cast<int>(score->nmeasures()));
+        obj.set("mscx", mscxMs);
+        obj.set("mscxBytes", static_cast<int>(mscxBytes));
+        obj.set("mscz", msczMs);
+        obj.set("msczBytes", static_cast<int>(msczBytes));
+
+        delete score;
+
+        return obj;
+    }
+};
+
+TEST_F(Engraving_SaveBenchmark, run)
+{
+    JsonArray results;
+
+    //! NOTE Synthetic giant scores
+    for (const SyntheticScores::Params& params : SyntheticScores::defaultParams()) {
+        const path_t path = path_t(params.name) + ".mscx";
+        ASSERT_TRUE(File::writeFile(path, SyntheticScores::generate(params)));
+
+        results.append(run(params.name, path));
+    }
+
+    //! NOTE The test corpus
+    const path_t scoresDir = envPath(SCORES_ENV, ENGRAVING_SAVE_BENCH_SCORES_DIR);
+    RetVal<paths_t> files = Dir::scanFiles(scoresDir, { "*.mscz" }, ScanMode::FilesInCurrentDir);
+    if (!files.ret) {
+        LOGW() << "no scores in: " << scoresDir;
+    }
+
+    for (const path_t& file : files.val) {
+        results.append(run(filename(file).toStdString(), file));
+    }
+
+    const path_t output = envPath(OUTPUT_ENV, DEFAULT_OUTPUT);
+    EXPECT_TRUE(File::writeFile(output, JsonDocument(results).toJson()));
+    LOGI() << "results written to: " << output;
+}
@@ -0,0 +1,155 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "syntheticscores.h"
+
+#include <sstream>
+
+using namespace mu::engraving;
+
+static const int PITCHES[] = { 60, 62, 64, 65, 67, 69, 71, 72 };
+static const int TPCS[] = { 14, 16, 18, 13, 15, 17, 19, 14 };
+static constexpr size_t PITCHES_COUNT = sizeof(PITCHES) / sizeof(PITCHES[0]);
+
+std::vector<SyntheticScores::Params> SyntheticScores::defaultParams()
+{
+    std::vector<Params> params;
+
+    Params manyStaves;
+    manyStaves.name = "synthetic-many-staves";
+    manyStaves.staves = 60;
+    manyStaves.measures = 64;
+    params.push_back(manyStaves);
+
+    Params denseTuplets;
+    denseTuplets.name = "synthetic-dense-tuplets";
+    denseTuplets.staves = 8;
+    denseTuplets.measures = 200;
+    denseTuplets.tuplets = true;
+    params.push_back(denseTuplets);
+
+    Params longSpanners;
+    longSpanners.name = "synthetic-long-spanners";
+    longSpanners.staves = 8;
+    longSpanners.measures = 200;
+    longSpanners.spannerMeasures = 16;
+    params.push_back(longSpanners);
+
+    return params;
+}
+
+static void writeChord(std::stringstream& ss, const char* durationType, size_t n, const std::string& spanner = std::string())
+{
+    const size_t idx = n % PITCHES_COUNT;
+    ss << "<Chord><durationType>" << durationType << "</durationType>"
+       << spanner
+       << "<Note><pitch>" << PITCHES[idx] << "</pitch><tpc>" << TPCS[idx] << "</tpc></Note>"
+       << "</Chord>\n";
+}
+
+static std::string spannerStart(const char* type, const std::string& body, size_t measures)
+{
+    std::stringstream ss;
+    ss << "<Spanner type=\"" << type << "\">" << body
+       << "<next><location><measures>" << measures << "</measures></location></next></Spanner>";
+    return ss.str();
+}
+
+static std::string spannerEnd(const char* type, size_t measures)
+{
+    std::stringstream ss;
+    ss << "<Spanner type=\"" << type << "\">"
+       << "<prev><location><measures>-" << measures << "</measures></location></prev></Spanner>";
+    return ss.str();
+}
+
+muse::ByteArray SyntheticScores::generate(const Params& params)
+{
+    std::stringstream ss;
+    ss << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+       << "<museScore version=\"4.40\">\n<Score>\n"
+       << "<Division>480</Division>\n"
+       << "<metaTag name=\"workTitle\">" << params.name << "</metaTag>\n";
+
+    for (size_t staff = 1; staff <= params.staves; ++staff) {
+        ss << "<Part id=\"" << staff << "\">"
+           << "<Staff id=\"" << staff << "\"><StaffType group=\"pitched\"><name>stdNormal</name></StaffType></Staff>"
+           << "<trackName>Piano " << staff << "</trackName>"
+           << "<Instrument id=\"piano\"><longName>Piano " << staff << "</longName><shortName>Pno. " << staff << "</shortName>"
+           << "<trackName>Piano " << staff << "</trackName><Channel><program value=\"0\"/></Channel></Instrument>"
+           << "</Part>\n";
+    }
+
+    const size_t span = params.spannerMeasures;
+
+    for (size_t staff = 1; staff <= params.staves; ++staff) {
+        ss << "<Staff id=\"" << staff << "\">\n";
+        size_t n = staff;
+        for (size_t m = 0; m < params.measures; ++m) {
+            ss << "<Measure><voice>\n";
+            if (m == 0) {
+                ss << "<Clef><concertClefType>G</concertClefType><transposingClefType>G</transposingClefType></Clef>"
+                   << "<TimeSig><sigN>4</sigN><sigD>4</sigD></TimeSig>\n";
+            }
+
+            // spanners start and end on the first beat, so the ranges of neighbouring spanners touch
+            const bool spannerEnds = span && m >= span && (m % span) == 0;
+            const bool spannerStarts = span && (m % span) == 0 && m + span < params.measures;
+            if (spannerEnds) {
+                ss << spannerEnd("HairPin", span);
+            }
+            if (spannerStarts) {
+                ss << spannerStart("HairPin", "<HairPin><subtype>" + std::to_string((m / span) % 2) + "</subtype></HairPin>", span);
+            }
+
+            for (size_t beat = 0; beat < 4; ++beat) {
+                if (params.tuplets) {
+                    ss << "<Tuplet><normalNotes>2</normalNotes><actualNotes>3</actualNotes><baseNote>eighth</baseNote>"
+                       << "<Number><style>tuplet</style><text>3</text></Number></Tuplet>\n";
+                    for (size_t i = 0; i < 3; ++i) {
+                        writeChord(ss, "eighth", n++);
+                    }
+                    ss << "<endTuplet/>\n";
+                    continue;
+                }
+
+                std::string slur;
+                if (beat == 0) {
+                    if (spannerEnds) {
+                        slur += spannerEnd("Slur", span);
+                    }
+                    if (spannerStarts) {
+                        slur += spannerStart("Slur", "<Slur></Slur>", span);
+                    }
+                }
+                writeChord(ss, "quarter", n++, slur);
+            }
+
+            ss << "</voice></Measure>\n";
+        }
+        ss << "</Staff>\n";
+    }
+
+    ss << "</Score>\n</museScore>\n";
+
+    const std::string str = ss.str();
+    return muse::ByteArray(str.data(), str.size());
+}
@@ -0,0 +1,49 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_ENGRAVING_SYNTHETICSCORES_H
+#define MU_ENGRAVING_SYNTHETICSCORES_H
+
+#include <string>
+#include <vector>
+
+#include "types/bytearray.h"
+
+namespace mu::engraving {
+//! NOTE Generates big scores in the mscx format, that stress particular parts of the layout
+class SyntheticScores
+{
+public:
+    struct Params {
+        std::string name;
+        size_t staves = 1;
+        size_t measures = 1;
+        bool tuplets = false;           // fill measures with eighth triplets
+        size_t spannerMeasures = 0;     // length of slurs and hairpins, 0 means no spanners
+    };
+
+    static std::vector<Params> defaultParams();
+
+    static muse::ByteArray generate(const Params& params);
+};
+}
+
+#endif // MU_ENGRAVING_SYNTHETICSCORES_H
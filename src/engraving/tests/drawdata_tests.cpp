@@ -24,6 +24,7 @@
 #include <cstring>
 
 #include "draw/types/drawdata.h"
+#include "draw/iimageprovider.h"
 #include "draw/painter.h"
 #include "draw/bufferedpaintprovider.h"
 #include "draw/utils/drawdatarw.h"
@@ -31,9 +32,16 @@
 
 #include "global/io/file.h"
 
+#include "engraving/dom/masterscore.h"
+#include "engraving/dom/mscore.h"
+#include "engraving/dom/page.h"
+#include "engraving/iengravingconfiguration.h"
+
 #include "devtools/drawdata/drawdataconverter.h"
 #include "devtools/drawdata/drawdatagenerator.h"
 
+#include "utils/scorerw.h"
+
 #include "log.h"
 
 using namespace mu;
@@ -307,3 +315,53 @@ TEST_F(Engraving_DrawDataTests, ScoreDrawDiff)
 
     saveDiff("4_diff.png", data1, diff.dataAdded);
 }
+
+//! Paints the thumbnail directly on the image, as Score::createThumbnail did before it was recorded
+static std::shared_ptr<Pixmap> paintThumbnailDirectly(Score* score)
+{
+    auto imageProvider = muse::modularity::globalIoc()->resolve<IImageProvider>("utests");
+    auto configuration = muse::modularity::globalIoc()->resolve<IEngravingConfiguration>("utests");
+
+    score->switchToPageMode();
+
+    RectF fr = score->pages().at(0)->abbox();
+    double mag = 256.0 / std::max(fr.width(), fr.height());
+    int w = int(fr.width() * mag);
+    int h = int(fr.height() * mag);
+
+    int dpm = lrint(DPMM * 1000.0);
+
+    auto pixmap = imageProvider->createPixmap(w, h, dpm, configuration->thumbnailBackgroundColor());
+
+    double pr = MScore::pixelRatio;
+    MScore::pixelRatio = 1.0;
+
+    Painter p(imageProvider->painterForImage(pixmap), "thumbnail");
+    p.setAntialiasing(true);
+    p.scale(mag, mag);
+    score->print(&p, 0);
+    p.endDraw();
+
+    MScore::pixelRatio = pr;
+
+    return pixmap;
+}
+
+TEST_F(Engraving_DrawDataTests, Thumbnail)
+{
+    // bold text is painted with drawTextWorkaround at the thumbnail scale
+    for (const char* name : { "accidental-1.mscx", "frametext.mscx", "staffEmptiness.mscx" }) {
+        //! GIVEN Score
+        MasterScore* score = ScoreRW::readScore((VTEST_SCORES + "/" + name).toString(), true);
+        ASSERT_TRUE(score);
+
+        //! DO Paint the thumbnail directly and through the recorded draw data
+        std::shared_ptr<Pixmap> origin = paintThumbnailDirectly(score);
+        std::shared_ptr<Pixmap> thumbnail = score->createThumbnail();
+
+        //! CHECK The images are identical
+        EXPECT_EQ(*origin, *thumbnail) << name;
+
+        delete score;
+    }
+}
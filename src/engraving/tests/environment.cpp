@@ -56,6 +56,7 @@ static muse::testing::SuiteEnvironment engraving_se(
     std::shared_ptr<ECMock> configurator(new ECMock(), [](ECMock*) {}); // no delete
     ON_CALL(*configurator, isAccessibleEnabled()).WillByDefault(::testing::Return(false));
     ON_CALL(*configurator, defaultColor()).WillByDefault(::testing::Return(muse::draw::Color::BLACK));
+    ON_CALL(*configurator, thumbnailBackgroundColor()).WillByDefault(::testing::Return(muse::draw::Color::WHITE));
 
     muse::modularity::globalIoc()->unregister<mu::engraving::IEngravingConfiguration>("utests");
     muse::modularity::globalIoc()->registerExport<mu::engraving::IEngravingConfiguration>("utests", configurator);
@@ -0,0 +1,107 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "dom/masterscore.h"
+#include "dom/measure.h"
+#include "dom/segment.h"
+
+#include "rendering/dev/horizontalspacing.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+using namespace mu::engraving::rendering::dev;
+
+static const String ALL_ELEMENTS_DATA_DIR(u"all_elements_data/");
+
+class Engraving_HorizontalSpacingTests : public ::testing::Test
+{
+};
+
+static std::vector<const Shape*> segmentShapes(Score* score)
+{
+    std::vector<const Shape*> shapes;
+    for (Segment* s = score->firstSegment(SegmentType::All); s; s = s->next1()) {
+        for (staff_idx_t staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
+            if (!s->staffShape(staffIdx).empty()) {
+                shapes.push_back(&s->staffShape(staffIdx));
+            }
+        }
+    }
+    return shapes;
+}
+
+//---------------------------------------------------------
+//   randomShape
+//    A few segment shapes moved by a random offset, so the
+//    elements of all types overlap in all ways
+//---------------------------------------------------------
+
+static Shape randomShape(std::mt19937& gen, const std::vector<const Shape*>& shapes, double spatium)
+{
+    std::uniform_int_distribution<size_t> shapeIdx(0, shapes.size() - 1);
+    std::uniform_int_distribution<int> count(1, 6);
+    std::uniform_real_distribution<double> offset(-3.0 * spatium, 3.0 * spatium);
+
+    Shape shape;
+    for (int i = count(gen); i > 0; --i) {
+        shape.add(shapes.at(shapeIdx(gen))->translated(PointF(offset(gen), offset(gen))));
+    }
+    return shape;
+}
+
+TEST_F(Engraving_HorizontalSpacingTests, IndexedDistanceEqualsPairwise)
+{
+    //! GIVEN The segment shapes of a score with many kinds of elements
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"layout_elements.mscx");
+    ASSERT_TRUE(score);
+
+    const std::vector<const Shape*> shapes = segmentShapes(score);
+    ASSERT_FALSE(shapes.empty());
+    const double spatium = score->style().spatium();
+
+    std::mt19937 gen(12345);
+    size_t indexedCount = 0;
+    for (int i = 0; i < 2000; ++i) {
+        //! DO Combine them into random shapes
+        const Shape f = randomShape(gen, shapes, spatium);
+        const Shape s = randomShape(gen, shapes, spatium);
+        const double squeezeFactor = (i % 2) ? 1.0 : 0.5;
+
+        //! CHECK The distance is exactly the pairwise one, also when it uses the index
+        EXPECT_EQ(HorizontalSpacing::minHorizontalDistance(f, s, spatium, squeezeFactor),
+                  HorizontalSpacing::minHorizontalDistancePairwise(f, s, spatium, squeezeFactor));
+
+        if (f.size() * s.size() >= 64) {
+            ++indexedCount;
+        }
+    }
+
+    EXPECT_GT(indexedCount, 0u);
+
+    delete score;
+}
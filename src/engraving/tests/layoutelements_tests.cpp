@@ -30,6 +30,10 @@
 #include "dom/system.h"
 #include "dom/tuplet.h"
 #include "dom/note.h"
+#include "dom/chord.h"
+#include "dom/segment.h"
+
+#include "rendering/dev/layoutcontext.h"
 
 #include "utils/scorerw.h"
 
@@ -44,6 +48,7 @@ class Engraving_LayoutElementsTests : public ::testing::Test
 {
 public:
     void tstLayoutAll(String file);
+    void tstMeasureLayoutCache(String file);
 };
 
 //---------------------------------------------------------
@@ -156,3 +161,310 @@ TEST_F(Engraving_LayoutElementsTests, tstLayoutCrossStaffArp)
 
     delete score;
 }
+
+//---------------------------------------------------------
+//   layoutSnapshot
+//    The type, position and bounding box of every item
+//---------------------------------------------------------
+
+struct ItemLayout {
+    ElementType type = ElementType::INVALID;
+    PointF pos;
+    RectF bbox;
+
+    bool operator==(const ItemLayout& other) const
+    {
+        return type == other.type && pos == other.pos && bbox == other.bbox;
+    }
+};
+
+static std::vector<ItemLayout> layoutSnapshot(Score* score)
+{
+    std::vector<ItemLayout> items;
+    score->scanElements(&items, [](void* data, EngravingItem* e) {
+        static_cast<std::vector<ItemLayout>*>(data)->push_back({ e->type(), e->pagePos(), e->ldata()->bbox() });
+    }, /* all */ true);
+    return items;
+}
+
+static Note* firstNote(Score* score)
+{
+    for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+        for (EngravingItem* e : s->elist()) {
+            if (e && e->isChord()) {
+                return toChord(e)->upNote();
+            }
+        }
+    }
+    return nullptr;
+}
+
+//---------------------------------------------------------
+//   tstMeasureLayoutCache
+//    Relayout after an edit must give the same result
+//    with the measure layout cache as without it
+//---------------------------------------------------------
+
+void Engraving_LayoutElementsTests::tstMeasureLayoutCache(String file)
+{
+    using namespace mu::engraving::rendering::dev;
+
+    MasterScore* reference = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + file);
+    MasterScore* cached = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + file);
+    ASSERT_TRUE(reference && cached);
+
+    cached->setMeasureLayoutCache(true);
+    // fills the fingerprints of all the measures
+    cached->doLayout();
+
+    LayoutDebug::instance()->cacheClear();
+
+    for (MasterScore* score : { reference, cached }) {
+        Note* note = firstNote(score);
+        ASSERT_TRUE(note);
+
+        score->startCmd();
+        note->undoChangeProperty(Pid::PITCH, note->pitch() + 1);
+        score->endCmd();
+    }
+
+    EXPECT_GT(LayoutDebug::instance()->cacheStats().hits, 0u);
+    EXPECT_TRUE(layoutSnapshot(reference) == layoutSnapshot(cached));
+
+    for (MasterScore* score : { reference, cached }) {
+        score->undoRedo(/* undo */ true, nullptr);
+    }
+
+    EXPECT_TRUE(layoutSnapshot(reference) == layoutSnapshot(cached));
+
+    delete reference;
+    delete cached;
+}
+
+TEST_F(Engraving_LayoutElementsTests, tstMeasureLayoutCacheElements)
+{
+    tstMeasureLayoutCache(u"layout_elements.mscx");
+}
+
+TEST_F(Engraving_LayoutElementsTests, tstMeasureLayoutCacheMoonlight)
+{
+    tstMeasureLayoutCache(u"moonlight.mscx");
+}
+
+//---------------------------------------------------------
+//   lazyLayoutScore
+//    Moonlight with provisional pages: the printable width
+//    is halved behind the layout's back, so the new systems
+//    never catch up with the previous layout
+//---------------------------------------------------------
+
+static MasterScore* lazyLayoutScore()
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    if (!score) {
+        return nullptr;
+    }
+
+    score->setLazyLayoutPages(1);
+    score->style().set(Sid::pagePrintableWidth, score->style().styleD(Sid::pagePrintableWidth) / 2);
+    score->doLayoutRange(Fraction(0, 1), Fraction(0, 1));
+
+    return score;
+}
+
+static Measure* firstMeasureNotLaidOut(Score* score)
+{
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        if (m->system() && m->system()->isProvisional()) {
+            return m;
+        }
+    }
+    return nullptr;
+}
+
+static bool isLaidOut(const Measure* measure)
+{
+    return measure->system() && !measure->system()->isProvisional() && measure->system()->page();
+}
+
+static Note* firstNote(Measure* measure)
+{
+    for (Segment* s = measure->first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
+        for (EngravingItem* e : s->elist()) {
+            if (e && e->isChord()) {
+                return toChord(e)->upNote();
+            }
+        }
+    }
+    return nullptr;
+}
+
+static bool allMeasuresOnPages(Score* score)
+{
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        if (!isLaidOut(m)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST_F(Engraving_LayoutElementsTests, tstLazyLayoutSelectBeyondLaidOutPages)
+{
+    MasterScore* score = lazyLayoutScore();
+    ASSERT_TRUE(score);
+    ASSERT_TRUE(score->hasProvisionalPages());
+
+    Measure* measure = firstMeasureNotLaidOut(score);
+    ASSERT_TRUE(measure);
+    Note* note = firstNote(measure);
+    ASSERT_TRUE(note);
+
+    // what the notation does when the navigation moves the selection
+    score->select(note);
+    score->layoutSelectionIfProvisional();
+
+    EXPECT_TRUE(isLaidOut(measure));
+
+    score->layoutProvisionalPages(/* all */ true);
+    EXPECT_FALSE(score->hasProvisionalPages());
+    EXPECT_TRUE(allMeasuresOnPages(score));
+
+    delete score;
+}
+
+TEST_F(Engraving_LayoutElementsTests, tstLazyLayoutEditBeyondLaidOutPages)
+{
+    MasterScore* score = lazyLayoutScore();
+    ASSERT_TRUE(score);
+    ASSERT_TRUE(score->hasProvisionalPages());
+
+    Measure* measure = firstMeasureNotLaidOut(score);
+    ASSERT_TRUE(measure);
+    Note* note = firstNote(measure);
+    ASSERT_TRUE(note);
+
+    // the edited range is always laid out, even beyond the laid out pages
+    score->startCmd();
+    note->undoChangeProperty(Pid::PITCH, note->pitch() + 1);
+    score->endCmd();
+
+    EXPECT_TRUE(isLaidOut(measure));
+
+    score->undoRedo(/* undo */ true, nullptr);
+    EXPECT_TRUE(isLaidOut(measure));
+
+    // completing the layout gives the same pages as a full layout
+    score->layoutProvisionalPages(/* all */ true);
+    EXPECT_FALSE(score->hasProvisionalPages());
+    EXPECT_TRUE(allMeasuresOnPages(score));
+
+    const size_t npages = score->npages();
+    score->doLayout();
+    EXPECT_EQ(score->npages(), npages);
+
+    delete score;
+}
+
+TEST_F(Engraving_LayoutElementsTests, tstLazyLayoutEditAtEndOfScore)
+{
+    MasterScore* score = lazyLayoutScore();
+    ASSERT_TRUE(score);
+    ASSERT_TRUE(score->hasProvisionalPages());
+
+    //! GIVEN the last measures that are not laid out and the last measure of the score
+    Measure* measure = nullptr;
+    for (Measure* m = score->lastMeasure(); m && !measure; m = m->prevMeasure()) {
+        if (!isLaidOut(m)) {
+            measure = m;
+        }
+    }
+    ASSERT_TRUE(measure);
+
+    for (Measure* m : { measure, score->lastMeasure() }) {
+        Note* note = firstNote(m);
+        ASSERT_TRUE(note);
+
+        //! CHECK they are on a system and a page, which the edit code relies on
+        ASSERT_TRUE(m->system());
+        ASSERT_TRUE(m->system()->page());
+        EXPECT_TRUE(m->system()->staff(note->staffIdx()));
+        note->pagePos();
+
+        //! DO edit them
+        score->startCmd();
+        note->undoChangeProperty(Pid::PITCH, note->pitch() - 1);
+        score->endCmd();
+
+        //! CHECK the edited measure is laid out
+        EXPECT_TRUE(isLaidOut(m));
+
+        score->undoRedo(/* undo */ true, nullptr);
+        EXPECT_TRUE(isLaidOut(m));
+    }
+
+    score->layoutProvisionalPages(/* all */ true);
+    EXPECT_FALSE(score->hasProvisionalPages());
+    EXPECT_TRUE(allMeasuresOnPages(score));
+
+    const size_t npages = score->npages();
+    score->doLayout();
+    EXPECT_EQ(score->npages(), npages);
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   skylinesSnapshot
+//    The skyline rectangles of every staff of every system
+//---------------------------------------------------------
+
+struct SkylineRect {
+    ElementType type = ElementType::INVALID;
+    RectF rect;
+
+    bool operator==(const SkylineRect& other) const
+    {
+        return type == other.type && rect == other.rect;
+    }
+};
+
+static std::vector<SkylineRect> skylinesSnapshot(Score* score)
+{
+    std::vector<SkylineRect> rects;
+    for (System* system : score->systems()) {
+        for (SysStaff* ss : system->staves()) {
+            for (const SkylineLine* line : { &ss->skyline().north(), &ss->skyline().south() }) {
+                for (const ShapeElement& el : line->elements()) {
+                    rects.push_back({ el.item() ? el.item()->type() : ElementType::INVALID, el });
+                }
+                // separates the lines, so that the staves can't compensate each other
+                rects.push_back({});
+            }
+        }
+    }
+    return rects;
+}
+
+TEST_F(Engraving_LayoutElementsTests, tstParallelSkylines)
+{
+    //! GIVEN A score with more staves than the parallel skylines threshold
+    MasterScore* score = ScoreRW::readScore(u"implode_explode_data/explode1-ref.mscx");
+    ASSERT_TRUE(score);
+    ASSERT_GE(score->nstaves(), 4u);
+
+    //! DO Lay it out serially and in parallel
+    score->setParallelLayout(false);
+    score->doLayout();
+    const std::vector<SkylineRect> serial = skylinesSnapshot(score);
+
+    score->setParallelLayout(true);
+    score->doLayout();
+    const std::vector<SkylineRect> parallel = skylinesSnapshot(score);
+
+    //! CHECK The per-staff skylines are the same
+    EXPECT_FALSE(serial.empty());
+    EXPECT_TRUE(serial == parallel);
+
+    delete score;
+}
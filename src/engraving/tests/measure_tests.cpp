@@ -567,3 +567,53 @@ TEST_F(Engraving_MeasureTests, measureNumbers)
 
     delete score;
 }
+
+//---------------------------------------------------------
+//    tick2measure must follow inserting, deleting and undo of measures
+//---------------------------------------------------------
+
+static void checkTick2Measure(const Score* score)
+{
+    for (const Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        EXPECT_EQ(score->tick2measure(m->tick()), m);
+        EXPECT_EQ(score->tick2measure(m->tick() + m->ticks() / 2), m);
+        if (m->nextMeasure()) {
+            EXPECT_EQ(score->tick2segment(m->tick(), true, SegmentType::ChordRest), m->first(SegmentType::ChordRest));
+        }
+    }
+    EXPECT_EQ(score->tick2measure(score->lastMeasure()->endTick()), score->lastMeasure());
+    EXPECT_EQ(score->tick2measure(score->lastMeasure()->endTick() + Fraction(1, 4)), nullptr);
+}
+
+TEST_F(Engraving_MeasureTests, tick2measureIndex)
+{
+    MasterScore* score = ScoreRW::readScore(MEASURE_DATA_DIR + u"measure-insert_beginning.mscx");
+    EXPECT_TRUE(score);
+    checkTick2Measure(score);
+
+    score->startCmd();
+    score->insertMeasure(score->firstMeasure());
+    score->endCmd();
+    checkTick2Measure(score);
+
+    score->startCmd();
+    score->insertMeasure(score->lastMeasure());
+    score->insertMeasure(nullptr);
+    score->endCmd();
+    checkTick2Measure(score);
+
+    score->select(score->firstMeasure()->nextMeasure());
+    score->startCmd();
+    score->cmdTimeDelete();
+    score->endCmd();
+    checkTick2Measure(score);
+
+    score->undoRedo(true, nullptr);
+    checkTick2Measure(score);
+    score->undoRedo(true, nullptr);
+    checkTick2Measure(score);
+    score->undoRedo(false, nullptr);
+    checkTick2Measure(score);
+
+    delete score;
+}
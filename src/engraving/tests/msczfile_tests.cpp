@@ -24,8 +24,10 @@
 #include <QByteArray>
 
 #include "io/buffer.h"
+#include "io/file.h"
 #include "infrastructure/mscwriter.h"
 #include "infrastructure/mscreader.h"
+#include "infrastructure/msccache.h"
 
 using namespace mu;
 using namespace muse;
@@ -88,3 +90,97 @@ TEST_F(Engraving_MsczFileTests, MsczFile_WriteRead)
         EXPECT_EQ(imageData, originImageData);
     }
 }
+
+static void writeMsczFile(const String& filePath, const ByteArray& scoreData, const ByteArray& imageData)
+{
+    MscWriter::Params params;
+    params.filePath = filePath;
+    params.mode = MscIoMode::Zip;
+
+    MscWriter writer(params);
+    writer.open();
+
+    writer.writeScoreFile(scoreData);
+    writer.addImageFile(u"image1.png", imageData);
+}
+
+static ByteArray readMsczScoreFile(const String& filePath, const ByteArray& expectedImageData)
+{
+    MscReader::Params params;
+    params.filePath = filePath;
+    params.mode = MscIoMode::Zip;
+    params.useCache = true;
+
+    MscReader reader(params);
+    reader.open();
+
+    EXPECT_EQ(reader.imageFileNames().size(), 1);
+    EXPECT_EQ(reader.readImageFile(u"image1.png"), expectedImageData);
+
+    return reader.readScoreFile();
+}
+
+TEST_F(Engraving_MsczFileTests, MsczFile_ReadThroughCache)
+{
+    //! CASE Reading a file through its cache, which must follow changes of the file
+
+    const String filePath = u"cached1.mscz";
+    const path_t cachePath = MscCache::cachePath(filePath);
+    File::remove(cachePath);
+
+    //! GIVEN A file
+    writeMsczFile(filePath, ByteArray("score"), ByteArray("image"));
+
+    //! DO Read it twice
+    //! CHECK The first read makes the cache, the second one is served from it
+    EXPECT_EQ(readMsczScoreFile(filePath, ByteArray("image")), ByteArray("score"));
+    EXPECT_TRUE(File::exists(cachePath));
+    EXPECT_EQ(readMsczScoreFile(filePath, ByteArray("image")), ByteArray("score"));
+
+    //! DO Change the file and read it again
+    //! CHECK The stale cache is not used
+    writeMsczFile(filePath, ByteArray("changed score"), ByteArray("changed image"));
+    EXPECT_EQ(readMsczScoreFile(filePath, ByteArray("changed image")), ByteArray("changed score"));
+
+    File::remove(cachePath);
+    File::remove(filePath);
+}
+
+TEST_F(Engraving_MsczFileTests, MsczFile_RewriteOpenedCache)
+{
+    //! CASE Rewriting a cache that is opened (mapped) by another reader
+
+    const path_t cachePath = MscCache::cachePath(u"cached2.mscz");
+    const ByteArray source("source");
+    const ByteArray changedSource("changed source");
+
+    //! GIVEN An opened cache
+    ASSERT_TRUE(MscCache::write(cachePath, source, { { u"score.mscx", ByteArray("score") } }));
+
+    MscCache cache;
+    ASSERT_TRUE(cache.open(cachePath, source));
+
+    //! DO Write a new cache over it
+    Ret ret = MscCache::write(cachePath, changedSource, { { u"score.mscx", ByteArray("changed score, a bit longer") } });
+
+    //! CHECK The opened one still reads its own data
+    EXPECT_EQ(cache.fileData(u"score.mscx", false), ByteArray("score"));
+
+#ifdef Q_OS_WIN
+    //! CHECK A mapped file can't be replaced there, the old cache stays
+    EXPECT_FALSE(ret);
+    cache.close();
+#else
+    //! CHECK A new reader reads the new data
+    EXPECT_TRUE(ret);
+
+    MscCache changedCache;
+    ASSERT_TRUE(changedCache.open(cachePath, changedSource));
+    EXPECT_EQ(changedCache.fileData(u"score.mscx", false), ByteArray("changed score, a bit longer"));
+
+    cache.close();
+    changedCache.close();
+#endif
+
+    File::remove(cachePath);
+}
@@ -31,6 +31,7 @@
 #include "dom/factory.h"
 #include "dom/fingering.h"
 #include "dom/image.h"
+#include "dom/imageStore.h"
 #include "dom/masterscore.h"
 #include "dom/measure.h"
 #include "dom/measurerepeat.h"
@@ -39,10 +40,19 @@
 #include "dom/segment.h"
 #include "dom/spanner.h"
 
+#include "io/buffer.h"
+
+#include "engraving/compat/scoreaccess.h"
+#include "engraving/rw/mscloader.h"
+#include "engraving/rw/mscsaver.h"
+#include "infrastructure/mscwriter.h"
+
 #include "utils/scorerw.h"
 #include "utils/scorecomp.h"
 
 using namespace mu;
+using namespace muse;
+using namespace muse::io;
 using namespace mu::engraving;
 
 static const String PARTS_DATA_DIR("parts_data/");
@@ -1270,6 +1280,159 @@ TEST_F(Engraving_PartsTests, partSpanners)
     MScore::useRead302InTestMode = useRead302;
 }
 
+//---------------------------------------------------------
+//   lazyImages
+//    images of a mscz file are kept as they are stored in
+//    the file and are uncompressed on first use
+//---------------------------------------------------------
+
+static MasterScore* loadMscz(ByteArray msczData)
+{
+    MasterScore* score = compat::ScoreAccess::createMasterScoreWithBaseStyle(nullptr);
+
+    Buffer buf(&msczData);
+    MscReader::Params params;
+    params.device = &buf;
+    params.filePath = u"part-image.mscz";
+    params.mode = MscIoMode::Zip;
+
+    MscReader reader(params);
+    reader.open();
+
+    SettingsCompat settingsCompat;
+    EXPECT_TRUE(MscLoader().loadMscz(score, reader, settingsCompat, false));
+
+    return score;
+}
+
+TEST_F(Engraving_PartsTests, lazyImages)
+{
+    static const String IMAGE_NAME(u"71b2e9f575296b78c22ba721cd71f6e5.png");
+
+    MasterScore* score = ScoreRW::readScore(PARTS_DATA_DIR + u"part-image.mscx");
+    ASSERT_TRUE(score);
+
+    ByteArray msczData;
+    {
+        Buffer buf(&msczData);
+        MscWriter::Params params;
+        params.device = &buf;
+        params.filePath = u"part-image.mscz";
+        params.mode = MscIoMode::Zip;
+
+        MscWriter writer(params);
+        writer.open();
+        EXPECT_TRUE(MscSaver(score->iocContext()).writeMscz(score, writer, false, false));
+    }
+    delete score;
+    imageStore.clearUnused();
+
+    MasterScore* eagerScore = loadMscz(msczData);
+    ImageStoreItem* eagerItem = imageStore.getImage(IMAGE_NAME);
+    ASSERT_TRUE(eagerItem);
+    const ByteArray imageData = eagerItem->buffer();
+    EXPECT_FALSE(imageData.empty());
+    delete eagerScore;
+    imageStore.clearUnused();
+
+    MScore::lazyLoadImages = true;
+    MasterScore* lazyScore = loadMscz(msczData);
+    MScore::lazyLoadImages = false;
+
+    // the file is closed, the data kept by the item is enough
+    msczData.clear();
+
+    ImageStoreItem* lazyItem = imageStore.getImage(IMAGE_NAME);
+    ASSERT_TRUE(lazyItem);
+    EXPECT_EQ(lazyItem->buffer(), imageData);
+    EXPECT_EQ(lazyItem->hash(), ImageStore::hashFromName(IMAGE_NAME));
+
+    delete lazyScore;
+    imageStore.clearUnused();
+}
+
+//---------------------------------------------------------
+//   reuseUnchangedExcerpts
+//    an excerpt not touched since the previous save is
+//    written again as it was, with the same result
+//---------------------------------------------------------
+
+static ByteArray writeMscx(MasterScore* score, MscSaver::ExcerptsCache* cache)
+{
+    ByteArray data;
+    Buffer buf(&data);
+    MscWriter::Params params;
+    params.device = &buf;
+    params.filePath = u"part-all-parts.mscx";
+    params.mode = MscIoMode::XmlFile;
+
+    MscWriter writer(params);
+    writer.open();
+    EXPECT_TRUE(MscSaver(score->iocContext()).writeMscz(score, writer, false, false, cache));
+    writer.close();
+
+    return data;
+}
+
+TEST_F(Engraving_PartsTests, reuseUnchangedExcerpts)
+{
+    MasterScore* score = ScoreRW::readScore(PARTS_DATA_DIR + u"part-all-parts.mscx");
+    ASSERT_TRUE(score);
+    ASSERT_EQ(score->excerpts().size(), 2);
+
+    MscSaver::ExcerptsCache cache;
+    EXPECT_EQ(writeMscx(score, &cache), writeMscx(score, nullptr));
+    EXPECT_EQ(cache.entries.size(), 2);
+
+    Score* alto = score->excerpts().at(0)->excerptScore();
+    Score* tenor = score->excerpts().at(1)->excerptScore();
+    const uint64_t altoRevision = alto->revision();
+    const uint64_t tenorRevision = tenor->revision();
+
+    Chord* chord = score->firstMeasure()->findChord(Fraction(0, 1), 0);
+    ASSERT_TRUE(chord);
+
+    score->startCmd();
+    chord->undoChangeProperty(Pid::SMALL, true);
+    score->endCmd();
+
+    EXPECT_NE(alto->revision(), altoRevision);
+    EXPECT_EQ(tenor->revision(), tenorRevision);
+
+    EXPECT_EQ(writeMscx(score, &cache), writeMscx(score, nullptr));
+
+    // undo touches the same scores
+    score->undoRedo(true, nullptr);
+    EXPECT_EQ(tenor->revision(), tenorRevision);
+    EXPECT_EQ(writeMscx(score, &cache), writeMscx(score, nullptr));
+
+    delete score;
+}
+
+TEST_F(Engraving_PartsTests, reuseExcerptsAfterRename)
+{
+    MasterScore* score = ScoreRW::readScore(PARTS_DATA_DIR + u"part-all-parts.mscx");
+    ASSERT_TRUE(score);
+    ASSERT_EQ(score->excerpts().size(), 2);
+
+    MscSaver::ExcerptsCache cache;
+    writeMscx(score, &cache);
+
+    //! DO rename a part between two saves, outside the undo stack
+    Excerpt* alto = score->excerpts().at(0);
+    const uint64_t altoRevision = alto->excerptScore()->revision();
+    alto->setName(u"Renamed part");
+
+    //! CHECK the part is written again with its new name
+    EXPECT_NE(alto->excerptScore()->revision(), altoRevision);
+
+    const ByteArray data = writeMscx(score, &cache);
+    EXPECT_EQ(data, writeMscx(score, nullptr));
+    EXPECT_TRUE(String::fromUtf8(data).contains(u"Renamed part"));
+
+    delete score;
+}
+
 //---------------------------------------------------------
 //   staffStyles
 //---------------------------------------------------------
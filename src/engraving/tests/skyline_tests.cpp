@@ -0,0 +1,106 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "infrastructure/shape.h"
+#include "infrastructure/skyline.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+class Engraving_SkylineTests : public ::testing::Test
+{
+};
+
+//---------------------------------------------------------
+//   randomShape
+//    Rectangles of random size, some of them empty or
+//    spanning the whole width like the staff lines
+//---------------------------------------------------------
+
+static Shape randomShape(std::mt19937& gen, size_t count, double y)
+{
+    std::uniform_real_distribution<double> x(0.0, 1000.0);
+    std::uniform_real_distribution<double> size(0.0, 30.0);
+    std::uniform_real_distribution<double> dy(-20.0, 20.0);
+    std::uniform_int_distribution<int> kind(0, 19);
+
+    Shape shape;
+    for (size_t i = 0; i < count; ++i) {
+        switch (kind(gen)) {
+        case 0: // full width
+            shape.add(RectF(0.0, y + dy(gen), 1000.0, 1.0));
+            break;
+        case 1: // zero width
+            shape.add(RectF(x(gen), y + dy(gen), 0.0, size(gen)));
+            break;
+        case 2: // zero height
+            shape.add(RectF(x(gen), y + dy(gen), size(gen), 0.0));
+            break;
+        default:
+            shape.add(RectF(x(gen), y + dy(gen), size(gen), size(gen)));
+            break;
+        }
+    }
+    return shape;
+}
+
+static SkylineLine skylineLine(const Shape& shape, bool north)
+{
+    SkylineLine line(north);
+    for (const ShapeElement& el : shape.elements()) {
+        line.add(el);
+    }
+    return line;
+}
+
+TEST_F(Engraving_SkylineTests, DistancesEqualShapeDistances)
+{
+    //! GIVEN Random shapes, both below and above the pairwise threshold
+    std::mt19937 gen(12345);
+    const std::vector<size_t> counts = { 1, 3, 10, 40, 200, 1000 };
+    const std::vector<double> clearances = { 0.0, 0.5, 3.0 };
+
+    for (size_t upperCount : counts) {
+        for (size_t lowerCount : counts) {
+            const Shape upper = randomShape(gen, upperCount, 0.0);
+            const Shape lower = randomShape(gen, lowerCount, 15.0);
+            const SkylineLine south = skylineLine(upper, false);
+            const SkylineLine north = skylineLine(lower, true);
+
+            //! CHECK The skyline queries give exactly the pairwise results of Shape
+            for (double clearance : clearances) {
+                const double expected = upper.minVerticalDistance(lower, clearance);
+                EXPECT_EQ(south.minDistance(north, clearance), expected);
+                EXPECT_EQ(north.minDistanceToShapeAbove(upper, clearance), expected);
+                EXPECT_EQ(south.minDistanceToShapeBelow(lower, clearance), expected);
+            }
+
+            const double clearance = upper.verticalClearance(lower);
+            EXPECT_EQ(north.verticalClearanceAbove(upper), clearance);
+            EXPECT_EQ(south.verticalClaranceBelow(lower), clearance);
+        }
+    }
+}
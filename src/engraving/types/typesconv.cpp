@@ -21,6 +21,9 @@
  */
 #include "typesconv.h"
 
+#include <string_view>
+#include <unordered_map>
+
 #include "global/types/translatablestring.h"
 
 #include "draw/types/drawtypes.h"
@@ -320,6 +323,21 @@ AsciiStringView TConv::toXml(ElementType v)
 
 ElementType TConv::fromXml(const AsciiStringView& tag, ElementType def, bool silent)
 {
+    //! NOTE Looked up for every element while reading, so the tags are indexed once
+    static const std::unordered_map<std::string_view, ElementType> index = []() {
+        std::unordered_map<std::string_view, ElementType> idx;
+        idx.reserve(ELEMENT_TYPES.size());
+        for (const Item<ElementType>& i : ELEMENT_TYPES) {
+            idx.emplace(i.xml, i.type);
+        }
+        return idx;
+    }();
+
+    auto it = index.find(tag);
+    if (it != index.end()) {
+        return it->second;
+    }
+
     return findTypeByXmlTag<ElementType>(ELEMENT_TYPES, tag, def, silent);
 }
 
@@ -354,6 +372,26 @@ String TConv::toXml(Align v)
     return sl.join(u",");
 }
 
+Align TConv::fromXml(const AsciiStringView& str, Align def)
+{
+    // bad values are reported by the String version
+    const size_t comma = str.indexOf(',');
+    if (comma == muse::nidx) {
+        return fromXml(String::fromAscii(str.ascii(), str.size()), def);
+    }
+
+    const AsciiStringView h(str.ascii(), comma);
+    const AsciiStringView v(str.ascii() + comma + 1, str.size() - comma - 1);
+    if (v.contains(',')) {
+        return fromXml(String::fromAscii(str.ascii(), str.size()), def);
+    }
+
+    Align a;
+    a.horizontal = findTypeByXmlTag<AlignH>(ALIGN_H, h, def.horizontal);
+    a.vertical = findTypeByXmlTag<AlignV>(ALIGN_V, v, def.vertical);
+    return a;
+}
+
 Align TConv::fromXml(const String& str, Align def)
 {
     StringList sl = str.split(',');
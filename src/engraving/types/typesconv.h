@@ -48,6 +48,7 @@ public:
 
     static String toXml(Align v);
     static Align fromXml(const String& str, Align def);
+    static Align fromXml(const AsciiStringView& str, Align def);
     static AlignH fromXml(const AsciiStringView& str, AlignH def);
     static AlignV fromXml(const AsciiStringView& str, AlignV def);
 
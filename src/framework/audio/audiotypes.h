@@ -100,6 +100,16 @@ struct SoundTrackFormat {
     }
 };
 
+//! NOTE The mix when trackId is invalid, otherwise the stem of the track channel (or aux channel)
+//! taken before mixing
+struct SoundTrackTarget {
+    io::path_t destination;
+    SoundTrackFormat format;
+    TrackId trackId = INVALID_TRACK_ID;
+};
+
+using SoundTrackTargets = std::vector<SoundTrackTarget>;
+
 using AudioSourceName = std::string;
 using AudioResourceId = std::string;
 using AudioResourceIdList = std::vector<AudioResourceId>;
@@ -53,6 +53,8 @@ public:
 
     virtual async::Promise<bool> saveSoundTrack(const TrackSequenceId sequenceId, const io::path_t& destination,
                                                 const SoundTrackFormat& format) = 0;
+    //! NOTE Renders the sequence once for all the targets, including the stems of the track channels
+    virtual async::Promise<bool> saveSoundTracks(const TrackSequenceId sequenceId, const SoundTrackTargets& targets) = 0;
     virtual void abortSavingAllSoundTracks() = 0;
 
     virtual Progress saveSoundTrackProgress(const TrackSequenceId sequenceId) = 0;
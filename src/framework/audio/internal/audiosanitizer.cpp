@@ -23,12 +23,13 @@
 
 #include <thread>
 
-#include "global/concurrency/taskscheduler.h"
+#include "worker/audioworkerpool.h"
 
 using namespace muse::audio;
 
 static std::thread::id s_as_mainThreadID;
 static std::thread::id s_as_workerThreadID;
+static const AudioWorkerPool* s_as_workerPool = nullptr;
 
 void AudioSanitizer::setupMainThread()
 {
@@ -59,5 +60,10 @@ bool AudioSanitizer::isWorkerThread()
 {
     std::thread::id id = std::this_thread::get_id();
 
-    return TaskScheduler::instance()->containsThread(id) || id == s_as_workerThreadID;
+    return id == s_as_workerThreadID || (s_as_workerPool && s_as_workerPool->containsThread(id));
+}
+
+void AudioSanitizer::setupWorkerPool(const AudioWorkerPool* pool)
+{
+    s_as_workerPool = pool;
 }
@@ -28,6 +28,7 @@
 #include <thread>
 
 namespace muse::audio {
+class AudioWorkerPool;
 class AudioSanitizer
 {
 public:
@@ -39,6 +40,9 @@ public:
     static void setupWorkerThread();
     static std::thread::id workerThread();
     static bool isWorkerThread();
+
+    //! NOTE The threads of the pool count as the worker thread
+    static void setupWorkerPool(const AudioWorkerPool* pool);
 };
 }
 
@@ -43,21 +43,18 @@ public:
         closeDestination();
     }
 
-    virtual bool init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesNumber)
+    //! NOTE The track may be passed to encode() in several consecutive parts,
+    //! totalSamplesPerChannel is the sum of all of them
+    virtual bool init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesPerChannel)
     {
         if (!format.isValid()) {
             return false;
         }
 
         m_format = format;
+        m_totalSamplesPerChannel = totalSamplesPerChannel;
 
-        if (!openDestination(path)) {
-            return false;
-        }
-
-        prepareOutputBuffer(totalSamplesNumber);
-
-        return true;
+        return openDestination(path);
     }
 
     const SoundTrackFormat& format() const
@@ -65,6 +62,7 @@ public:
         return m_format;
     }
 
+    //! NOTE Returns 0 if failed
     virtual size_t encode(samples_t samplesPerChannel, const float* input) = 0;
     virtual size_t flush() = 0;
 
@@ -74,28 +72,11 @@ public:
     }
 
 protected:
-    virtual size_t requiredOutputBufferSize(samples_t totalSamplesNumber) const = 0;
-
-    virtual void prepareWriting()
-    {
-#ifdef Q_OS_WIN
-        //!Note See https://learn.microsoft.com/en-us/cpp/c-runtime-library/reference/setlocale-wsetlocale
-        //!     UTF-8 support
-        m_locale = setlocale(LC_ALL, nullptr);
-        setlocale(LC_ALL, ".UTF8");
-#endif
-    }
-
-    virtual void completeWriting()
-    {
-#ifdef Q_OS_WIN
-        setlocale(LC_ALL, m_locale.c_str());
-#endif
-    }
+    virtual size_t requiredOutputBufferSize(samples_t samplesPerChannel) const = 0;
 
+    //! NOTE On Windows, the destination is opened in the UTF-8 locale set by SoundTrackWriter::write
     virtual bool openDestination(const io::path_t& path)
     {
-        prepareWriting();
         m_fileStream = std::fopen(path.c_str(), "wb+");
 
         if (!m_fileStream) {
@@ -105,9 +86,13 @@ protected:
         return true;
     }
 
-    virtual void prepareOutputBuffer(const samples_t totalSamplesNumber)
+    //! NOTE Allocates only when a larger part than before is encoded
+    virtual void prepareOutputBuffer(const samples_t samplesPerChannel)
     {
-        m_outputBuffer.resize(requiredOutputBufferSize(totalSamplesNumber));
+        size_t requiredSize = requiredOutputBufferSize(samplesPerChannel);
+        if (m_outputBuffer.size() < requiredSize) {
+            m_outputBuffer.resize(requiredSize);
+        }
     }
 
     virtual void closeDestination()
@@ -115,17 +100,14 @@ protected:
         if (m_fileStream) {
             std::fclose(m_fileStream);
         }
-
-        completeWriting();
     }
 
     std::FILE* m_fileStream = nullptr;
     std::vector<unsigned char> m_outputBuffer;
 
     SoundTrackFormat m_format;
+    samples_t m_totalSamplesPerChannel = 0;
     Progress m_progress;
-
-    std::string m_locale;
 };
 
 using AbstractAudioEncoderPtr = std::unique_ptr<AbstractAudioEncoder>;
@@ -54,13 +54,14 @@ struct FlacHandler : public FLAC::Encoder::File
     ProgressCallBack m_callBack;
 };
 
-bool FlacEncoder::init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesNumber)
+bool FlacEncoder::init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesPerChannel)
 {
     if (!format.isValid()) {
         return false;
     }
 
     m_format = format;
+    m_totalSamplesPerChannel = totalSamplesPerChannel;
 
     m_flac = new FlacHandler([this](int64_t current, int64_t total){
         m_progress.progressChanged.send(current, total, "");
@@ -71,7 +72,7 @@ bool FlacEncoder::init(const io::path_t& path, const SoundTrackFormat& format, c
         || !m_flac->set_channels(m_format.audioChannelsNumber)
         || !m_flac->set_sample_rate(m_format.sampleRate)
         || !m_flac->set_bits_per_sample(16)
-        || !m_flac->set_total_samples_estimate(totalSamplesNumber)) {
+        || !m_flac->set_total_samples_estimate(totalSamplesPerChannel)) {
         return false;
     }
 
@@ -87,13 +88,7 @@ bool FlacEncoder::init(const io::path_t& path, const SoundTrackFormat& format, c
     metadata[1]->length = 1234; /* set the padding length */
     m_flac->set_metadata(metadata, 2);
 
-    if (!openDestination(path)) {
-        return false;
-    }
-
-    prepareOutputBuffer(totalSamplesNumber);
-
-    return true;
+    return openDestination(path);
 }
 
 size_t FlacEncoder::encode(samples_t samplesPerChannel, const float* input)
@@ -102,30 +97,20 @@ size_t FlacEncoder::encode(samples_t samplesPerChannel, const float* input)
         return 0;
     }
 
-    size_t result = 0;
-    size_t totalSamplesNumber = samplesPerChannel * m_format.audioChannelsNumber;
-    uint32_t frameSize = 1024;
-    size_t stepSize = frameSize * m_format.audioChannelsNumber;
+    size_t samplesNumber = samplesPerChannel * m_format.audioChannelsNumber;
 
-    std::vector<FLAC__int32> buff(samplesPerChannel * sizeof(float));
+    std::vector<FLAC__int32> buff(samplesNumber);
 
-    for (size_t i = 0; i < buff.size(); ++i) {
+    for (size_t i = 0; i < samplesNumber; ++i) {
         buff[i] = static_cast<FLAC__int32>(dsp::convertFloatSamples<FLAC__int16>(input[i]));
     }
 
-    std::vector<FLAC__int32> intermBuff(stepSize);
-
-    for (size_t i = 0; i < totalSamplesNumber; i += stepSize) {
-        std::copy(buff.data() + i, buff.data() + i + stepSize, intermBuff.data());
-
-        if (m_flac->process_interleaved(intermBuff.data(), frameSize)) {
-            result += stepSize;
-        } else {
-            break;
-        }
+    //! NOTE The encoder keeps the samples of a part until it has a whole block
+    if (!m_flac->process_interleaved(buff.data(), samplesPerChannel)) {
+        return 0;
     }
 
-    return result;
+    return samplesNumber;
 }
 
 size_t FlacEncoder::flush()
@@ -134,9 +119,9 @@ size_t FlacEncoder::flush()
     return 0;
 }
 
-size_t FlacEncoder::requiredOutputBufferSize(samples_t totalSamplesNumber) const
+size_t FlacEncoder::requiredOutputBufferSize(samples_t /*samplesPerChannel*/) const
 {
-    return totalSamplesNumber;
+    return 0;
 }
 
 bool FlacEncoder::openDestination(const io::path_t& path)
@@ -81,42 +81,41 @@ private:
     }
 };
 
-size_t WavEncoder::encode(samples_t samplesPerChannel, const float* input)
+bool WavEncoder::init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesPerChannel)
 {
-    if (!m_fileStream.is_open()) {
-        return 0;
+    if (!AbstractAudioEncoder::init(path, format, totalSamplesPerChannel)) {
+        return false;
     }
 
+    //! NOTE The header is written before the samples, so it takes the count of all the parts
     WavHeader header;
     header.chunkSize = 18; // 18 is 2 bytes more to include cbsize field / extension size
     header.bitsPerSample = 32;
     header.code = 3; // IEEE_FLOAT = 3, PCM = 1
     header.audioChannelsNumber = m_format.audioChannelsNumber;
     header.sampleRate = m_format.sampleRate;
-    header.samplesPerChannel = samplesPerChannel;
+    header.samplesPerChannel = totalSamplesPerChannel;
 
     header.write(m_fileStream);
 
-    int total = header.samplesPerChannel;
-    int progressStep = (total * 5) / 100; // every 5%
-    QVector<samples_t> progressValues;
-    for (samples_t sampleIdx = 0; sampleIdx < header.samplesPerChannel;) {
-        progressValues << sampleIdx;
-        sampleIdx += progressStep;
+    return m_fileStream.good();
+}
+
+size_t WavEncoder::encode(samples_t samplesPerChannel, const float* input)
+{
+    if (!m_fileStream.is_open()) {
+        return 0;
     }
 
-    for (samples_t sampleIdx = 0; sampleIdx < header.samplesPerChannel; ++sampleIdx) {
-        for (audioch_t audioChNum = 0; audioChNum < m_format.audioChannelsNumber; ++audioChNum) {
-            int idx = sampleIdx * m_format.audioChannelsNumber + audioChNum;
-            m_fileStream.write(reinterpret_cast<const char*>(input + idx), 4);
-        }
+    const size_t samplesNumber = samplesPerChannel * m_format.audioChannelsNumber;
 
-        if (progressValues.contains(sampleIdx)) {
-            m_progress.progressChanged.send(sampleIdx, total, "");
-        }
+    // the samples are interleaved already, little endian like the header
+    m_fileStream.write(reinterpret_cast<const char*>(input), samplesNumber * sizeof(float));
+    if (!m_fileStream.good()) {
+        return 0;
     }
 
-    return samplesPerChannel * m_format.audioChannelsNumber;
+    return samplesNumber;
 }
 
 size_t WavEncoder::flush()
@@ -126,14 +125,13 @@ size_t WavEncoder::flush()
     return 0;
 }
 
-size_t WavEncoder::requiredOutputBufferSize(samples_t totalSamplesNumber) const
+size_t WavEncoder::requiredOutputBufferSize(samples_t /*samplesPerChannel*/) const
 {
-    return totalSamplesNumber;
+    return 0;
 }
 
 bool WavEncoder::openDestination(const io::path_t& path)
 {
-    prepareWriting();
     m_fileStream.open(path.toStdString(), std::ios_base::binary);
 
     return m_fileStream.is_open();
@@ -142,6 +140,4 @@ bool WavEncoder::openDestination(const io::path_t& path)
 void WavEncoder::closeDestination()
 {
     m_fileStream.close();
-
-    completeWriting();
 }
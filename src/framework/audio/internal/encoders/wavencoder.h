@@ -31,6 +31,8 @@ namespace muse::audio::encode {
 class WavEncoder : public AbstractAudioEncoder
 {
 public:
+    bool init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesPerChannel) override;
+
     size_t encode(samples_t samplesPerChannel, const float* input) override;
     size_t flush() override;
 
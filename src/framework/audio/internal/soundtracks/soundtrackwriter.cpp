@@ -22,6 +22,10 @@
 
 #include "soundtrackwriter.h"
 
+#include <clocale>
+#include <thread>
+
+#include "global/runtime.h"
 #include "global/defer.h"
 
 #include "internal/worker/audioengine.h"
@@ -38,79 +42,122 @@ using namespace muse;
 using namespace muse::audio;
 using namespace muse::audio::soundtrack;
 
-static constexpr int PREPARE_STEP = 0;
-static constexpr int ENCODE_STEP = 1;
+//! NOTE Blocks rendered by every track at once, see Mixer::processOffline
+static constexpr size_t OFFLINE_RENDER_BLOCKS = 64;
+
+//! NOTE One chunk is rendered while the other one is encoded
+static constexpr size_t CHUNK_COUNT = 2;
 
 SoundTrackWriter::SoundTrackWriter(const io::path_t& destination, const SoundTrackFormat& format,
-                                   const msecs_t totalDuration, IAudioSourcePtr source,
+                                   const msecs_t totalDuration, MixerPtr mixer,
                                    const modularity::ContextPtr& iocCtx)
-    : muse::Injectable(iocCtx), m_source(std::move(source))
+    : SoundTrackWriter(SoundTrackTargets { { destination, format } }, totalDuration, std::move(mixer), iocCtx)
 {
-    if (!m_source) {
+}
+
+SoundTrackWriter::SoundTrackWriter(const SoundTrackTargets& targets, const msecs_t totalDuration, MixerPtr mixer,
+                                   const modularity::ContextPtr& iocCtx)
+    : muse::Injectable(iocCtx), m_mixer(std::move(mixer))
+{
+    if (!m_mixer || targets.empty()) {
         return;
     }
 
-    samples_t totalSamplesNumber = (totalDuration / 1000000.f) * sizeof(float) * format.sampleRate;
-    m_inputBuffer.resize(totalSamplesNumber);
-    m_intermBuffer.resize(config()->renderStep() * config()->audioChannelsCount());
+    //! NOTE The mix and the stems are rendered once and shared by all the targets,
+    //! so they must agree on how they are rendered
+    const SoundTrackFormat& renderFormat = targets.front().format;
 
-    m_encoderPtr = createEncoder(format.type);
+    for (const SoundTrackTarget& target : targets) {
+        if (target.format.sampleRate != renderFormat.sampleRate
+            || target.format.audioChannelsNumber != renderFormat.audioChannelsNumber) {
+            LOGE() << "all the targets must have the same sample rate and channels number: " << target.destination;
+            m_targetsRet = make_ret(Err::MismatchedSoundTrackFormats);
+            m_outputs.clear();
+            return;
+        }
 
-    if (!m_encoderPtr) {
-        return;
+        m_outputs.push_back({ target.trackId, target.destination, target.format, nullptr });
     }
 
-    m_encoderPtr->init(destination, format, totalSamplesNumber);
-    m_encoderPtr->progress().progressChanged.onReceive(this, [this](int64_t current, int64_t total, std::string) {
-        sendStepProgress(ENCODE_STEP, current, total);
-    });
+    m_totalSamplesPerChannel = (totalDuration / 1000000.f) * renderFormat.sampleRate;
+
+    const size_t bufferSize = config()->renderStep() * config()->audioChannelsCount() * OFFLINE_RENDER_BLOCKS;
+
+    m_chunks.resize(CHUNK_COUNT);
+
+    for (Chunk& chunk : m_chunks) {
+        chunk.mix.resize(bufferSize);
+
+        for (const Output& output : m_outputs) {
+            if (output.trackId != INVALID_TRACK_ID) {
+                chunk.stems[output.trackId].resize(bufferSize);
+            }
+        }
+    }
 }
 
 Ret SoundTrackWriter::write()
 {
     TRACEFUNC;
 
-    if (!m_source || !m_encoderPtr) {
-        return false;
+    if (!m_targetsRet) {
+        return m_targetsRet;
     }
 
-    audioEngine()->setMode(RenderMode::OfflineMode);
+    if (!m_mixer || m_outputs.empty()) {
+        return false;
+    }
 
-    m_source->setSampleRate(m_encoderPtr->format().sampleRate);
-    m_source->setIsActive(true);
+#ifdef Q_OS_WIN
+    //!Note See https://learn.microsoft.com/en-us/cpp/c-runtime-library/reference/setlocale-wsetlocale
+    //!     UTF-8 support. The locale is global, so it is set once for all the encoders,
+    //!     which open their destinations and write to them on several threads
+    const std::string locale = setlocale(LC_ALL, nullptr);
+    setlocale(LC_ALL, ".UTF8");
 
     DEFER {
-        m_encoderPtr->flush();
-
-        audioEngine()->setMode(RenderMode::IdleMode);
-
-        m_source->setSampleRate(audioEngine()->sampleRate());
-        m_source->setIsActive(false);
+        setlocale(LC_ALL, locale.c_str());
+    };
+#endif
 
-        m_isAborted = false;
+    DEFER {
+        closeOutputs();
     };
 
-    Ret ret = generateAudioData();
+    Ret ret = openOutputs();
     if (!ret) {
         return ret;
     }
 
-    size_t bytes = m_encoderPtr->encode(m_inputBuffer.size() / sizeof(float), m_inputBuffer.data());
+    audioEngine()->setMode(RenderMode::OfflineMode);
 
-    if (m_isAborted) {
-        return make_ret(Ret::Code::Cancel);
-    }
+    m_mixer->setSampleRate(m_outputs.front().format.sampleRate);
+    m_mixer->setIsActive(true);
 
-    if (bytes == 0) {
-        return make_ret(Err::ErrorEncode);
-    }
+    DEFER {
+        for (Output& output : m_outputs) {
+            output.encoder->flush();
+        }
 
-    return muse::make_ok();
+        audioEngine()->setMode(RenderMode::IdleMode);
+
+        m_mixer->setSampleRate(audioEngine()->sampleRate());
+        m_mixer->setIsActive(false);
+
+        m_isAborted = false;
+    };
+
+    return renderAndEncode();
 }
 
 void SoundTrackWriter::abort()
 {
-    m_isAborted = true;
+    {
+        std::lock_guard lock(m_mutex);
+        m_isAborted = true;
+    }
+
+    m_condition.notify_all();
 }
 
 Progress SoundTrackWriter::progress()
@@ -132,46 +179,213 @@ encode::AbstractAudioEncoderPtr SoundTrackWriter::createEncoder(const SoundTrack
     return nullptr;
 }
 
-Ret SoundTrackWriter::generateAudioData()
+Ret SoundTrackWriter::openOutputs()
+{
+    for (Output& output : m_outputs) {
+        output.encoder = createEncoder(output.format.type);
+        if (!output.encoder || !output.encoder->init(output.destination, output.format, m_totalSamplesPerChannel)) {
+            LOGE() << "failed to open: " << output.destination;
+            return make_ret(Err::InvalidAudioFilePath);
+        }
+    }
+
+    return muse::make_ok();
+}
+
+void SoundTrackWriter::closeOutputs()
+{
+    //! NOTE The destinations are closed by the encoders, so that the files are complete once write returns
+    for (Output& output : m_outputs) {
+        output.encoder = nullptr;
+    }
+}
+
+Ret SoundTrackWriter::renderAndEncode()
 {
     TRACEFUNC;
 
-    size_t inputBufferOffset = 0;
-    size_t inputBufferMaxOffset = m_inputBuffer.size();
+    if (m_totalSamplesPerChannel == 0) {
+        LOGI() << "No audio to export";
+        return make_ret(Err::NoAudioToExport);
+    }
+
+    samples_t samplesPerChannelDone = 0;
+    sendProgress(samplesPerChannelDone, m_totalSamplesPerChannel);
+
+    const samples_t renderStep = config()->renderStep();
 
-    sendStepProgress(PREPARE_STEP, inputBufferOffset, inputBufferMaxOffset);
+    Mixer::ChannelOutputHandler stemHandler = nullptr;
+    if (!m_chunks.front().stems.empty()) {
+        stemHandler = [this](TrackId trackId, size_t offset, const float* data, size_t size) {
+            writeStemData(trackId, offset, data, size);
+        };
+    }
+
+    m_renderedChunks = 0;
+    m_isRenderingFinished = false;
+    m_isEncodeFailed = false;
+
+    for (Output& output : m_outputs) {
+        output.nextChunk = 0;
+        output.isEncoding = false;
+    }
+
+    for (Chunk& chunk : m_chunks) {
+        chunk.pendingOutputs = 0;
+    }
+
+    //! NOTE The encoder threads live until the whole score is encoded,
+    //! each output is encoded by a single thread at a time
+    const size_t hardwareThreads = std::max(std::thread::hardware_concurrency(), 2u);
+    const size_t threadCount = std::min<size_t>(m_outputs.size(), hardwareThreads - 1);
 
-    samples_t renderStep = config()->renderStep();
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
 
-    while (inputBufferOffset < inputBufferMaxOffset && !m_isAborted) {
-        m_source->process(m_intermBuffer.data(), renderStep);
+    for (size_t i = 0; i < threadCount; ++i) {
+        threads.emplace_back([this, i]() {
+            runtime::setThreadName("audio_encoder_" + std::to_string(i));
+            encodeChunks();
+        });
+    }
+
+    while (samplesPerChannelDone < m_totalSamplesPerChannel) {
+        Chunk& chunk = m_chunks[m_renderedChunks % m_chunks.size()];
+        if (!waitForFreeChunk(chunk)) {
+            break;
+        }
+
+        const samples_t samplesPerChannelLeft = m_totalSamplesPerChannel - samplesPerChannelDone;
+        const size_t blockCount = std::min<size_t>((samplesPerChannelLeft + renderStep - 1) / renderStep, OFFLINE_RENDER_BLOCKS);
+
+        //! NOTE A muted track, or an aux channel without a signal, isn't passed to the handler
+        for (auto& stem : chunk.stems) {
+            std::fill(stem.second.begin(), stem.second.end(), 0.f);
+        }
 
-        size_t samplesToCopy = std::min(m_intermBuffer.size(), inputBufferMaxOffset - inputBufferOffset);
+        m_renderingChunk = &chunk;
+        m_mixer->processOffline(chunk.mix.data(), renderStep, blockCount, stemHandler);
+        m_renderingChunk = nullptr;
 
-        std::copy(m_intermBuffer.begin(),
-                  m_intermBuffer.begin() + samplesToCopy,
-                  m_inputBuffer.begin() + inputBufferOffset);
+        chunk.samplesPerChannel = std::min<samples_t>(blockCount * renderStep, samplesPerChannelLeft);
 
-        inputBufferOffset += samplesToCopy;
-        sendStepProgress(PREPARE_STEP, inputBufferOffset, inputBufferMaxOffset);
+        {
+            std::lock_guard lock(m_mutex);
+            chunk.pendingOutputs = m_outputs.size();
+            ++m_renderedChunks;
+        }
+
+        m_condition.notify_all();
+
+        samplesPerChannelDone += chunk.samplesPerChannel;
+        sendProgress(samplesPerChannelDone, m_totalSamplesPerChannel);
+    }
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_isRenderingFinished = true;
+    }
+
+    m_condition.notify_all();
+
+    for (std::thread& thread : threads) {
+        thread.join();
     }
 
     if (m_isAborted) {
         return make_ret(Ret::Code::Cancel);
     }
 
-    if (inputBufferOffset == 0) {
-        LOGI() << "No audio to export";
-        return make_ret(Err::NoAudioToExport);
+    if (m_isEncodeFailed) {
+        return make_ret(Err::ErrorEncode);
     }
 
     return muse::make_ok();
 }
 
-void SoundTrackWriter::sendStepProgress(int step, int64_t current, int64_t total)
+bool SoundTrackWriter::waitForFreeChunk(const Chunk& chunk)
+{
+    std::unique_lock lock(m_mutex);
+    m_condition.wait(lock, [this, &chunk]() {
+        return chunk.pendingOutputs == 0 || m_isAborted || m_isEncodeFailed;
+    });
+
+    return !m_isAborted && !m_isEncodeFailed;
+}
+
+void SoundTrackWriter::writeStemData(TrackId trackId, size_t offset, const float* data, size_t size)
+{
+    auto it = m_renderingChunk->stems.find(trackId);
+    if (it == m_renderingChunk->stems.end()) {
+        return;
+    }
+
+    std::vector<float>& buffer = it->second;
+    if (offset >= buffer.size()) {
+        return;
+    }
+
+    size = std::min(size, buffer.size() - offset);
+    std::copy(data, data + size, buffer.begin() + offset);
+}
+
+void SoundTrackWriter::encodeChunks()
+{
+    std::unique_lock lock(m_mutex);
+
+    while (true) {
+        Output* output = nullptr;
+
+        m_condition.wait(lock, [this, &output]() {
+            if (m_isAborted || m_isEncodeFailed) {
+                return true;
+            }
+
+            for (Output& o : m_outputs) {
+                if (!o.isEncoding && o.nextChunk < m_renderedChunks) {
+                    output = &o;
+                    return true;
+                }
+            }
+
+            return m_isRenderingFinished;
+        });
+
+        if (!output) {
+            return;
+        }
+
+        Chunk& chunk = m_chunks[output->nextChunk % m_chunks.size()];
+        output->isEncoding = true;
+
+        //! NOTE The chunk is only read until all its outputs are encoded, so it's encoded without the lock
+        lock.unlock();
+        const bool ok = output->encoder->encode(chunk.samplesPerChannel, chunk.input(*output)) != 0;
+        lock.lock();
+
+        if (!ok) {
+            LOGE() << "failed to encode: " << output->destination;
+            m_isEncodeFailed = true;
+        }
+
+        output->isEncoding = false;
+        ++output->nextChunk;
+        --chunk.pendingOutputs;
+
+        m_condition.notify_all();
+    }
+}
+
+const float* SoundTrackWriter::Chunk::input(const Output& output) const
+{
+    if (output.trackId == INVALID_TRACK_ID) {
+        return mix.data();
+    }
+
+    return stems.at(output.trackId).data();
+}
+
+void SoundTrackWriter::sendProgress(int64_t current, int64_t total)
 {
-    int stepRange = step == PREPARE_STEP ? 80 : 20;
-    int stepProgressStart = step == PREPARE_STEP ? 0 : 80;
-    int stepCurrentProgress = stepProgressStart + ((current * 100 / total) * stepRange) / 100;
-    m_progress.progressChanged.send(stepCurrentProgress, 100, "");
+    m_progress.progressChanged.send(current * 100 / total, 100, "");
 }
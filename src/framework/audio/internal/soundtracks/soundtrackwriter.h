@@ -23,6 +23,9 @@
 #ifndef MUSE_AUDIO_SOUNDTRACKWRITER_H
 #define MUSE_AUDIO_SOUNDTRACKWRITER_H
 
+#include <condition_variable>
+#include <map>
+#include <mutex>
 #include <vector>
 
 #include "global/async/asyncable.h"
@@ -41,7 +44,9 @@ class SoundTrackWriter : public muse::Injectable, public async::Asyncable
     muse::Inject<IAudioEngine> audioEngine = { this };
 
 public:
-    SoundTrackWriter(const io::path_t& destination, const SoundTrackFormat& format, const msecs_t totalDuration, IAudioSourcePtr source,
+    SoundTrackWriter(const io::path_t& destination, const SoundTrackFormat& format, const msecs_t totalDuration, MixerPtr mixer,
+                     const muse::modularity::ContextPtr& iocCtx);
+    SoundTrackWriter(const SoundTrackTargets& targets, const msecs_t totalDuration, MixerPtr mixer,
                      const muse::modularity::ContextPtr& iocCtx);
 
     Ret write();
@@ -50,17 +55,58 @@ public:
     Progress progress();
 
 private:
+    struct Output {
+        TrackId trackId = INVALID_TRACK_ID;
+        io::path_t destination;
+        SoundTrackFormat format;
+        encode::AbstractAudioEncoderPtr encoder;
+
+        //! NOTE An output is encoded by one thread at a time, in the order of the chunks
+        size_t nextChunk = 0;
+        bool isEncoding = false;
+    };
+
+    //! NOTE The blocks rendered at once, see Mixer::processOffline
+    struct Chunk {
+        std::vector<float> mix;
+
+        //! NOTE The signal of the track channels taken before mixing, shared by the outputs of the same track
+        std::map<TrackId, std::vector<float> > stems;
+
+        samples_t samplesPerChannel = 0;
+        size_t pendingOutputs = 0;
+
+        const float* input(const Output& output) const;
+    };
+
     encode::AbstractAudioEncoderPtr createEncoder(const SoundTrackType& type) const;
-    Ret generateAudioData();
+    Ret openOutputs();
+    void closeOutputs();
+
+    Ret renderAndEncode();
+    bool waitForFreeChunk(const Chunk& chunk);
+    void writeStemData(TrackId trackId, size_t offset, const float* data, size_t size);
+    void encodeChunks();
+
+    void sendProgress(int64_t current, int64_t total);
 
-    void sendStepProgress(int step, int64_t current, int64_t total);
+    MixerPtr m_mixer = nullptr;
+    Ret m_targetsRet = muse::make_ok();
+    samples_t m_totalSamplesPerChannel = 0;
 
-    IAudioSourcePtr m_source = nullptr;
+    //! NOTE The chunks are reused in turn, so that the memory doesn't depend on the duration of the score.
+    //! The next chunk is rendered while the encoder threads encode the previous one
+    std::vector<Chunk> m_chunks;
+    Chunk* m_renderingChunk = nullptr;
 
-    std::vector<float> m_inputBuffer;
-    std::vector<float> m_intermBuffer;
+    std::vector<Output> m_outputs;
 
-    encode::AbstractAudioEncoderPtr m_encoderPtr = nullptr;
+    //! NOTE Guards the outputs and the chunks between the rendering thread and the encoder threads
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    size_t m_renderedChunks = 0;
+    bool m_isRenderingFinished = false;
+    bool m_isEncodeFailed = false;
 
     Progress m_progress;
     std::atomic<bool> m_isAborted = false;
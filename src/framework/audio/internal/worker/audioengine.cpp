@@ -47,7 +47,10 @@ Ret AudioEngine::init(AudioBufferPtr bufferPtr)
         return make_ret(Ret::Code::InternalError);
     }
 
-    m_mixer = std::make_shared<Mixer>(iocContext());
+    m_workerPool = std::make_shared<AudioWorkerPool>(AudioWorkerPool::defaultThreadCount());
+    AudioSanitizer::setupWorkerPool(m_workerPool.get());
+
+    m_mixer = std::make_shared<Mixer>(iocContext(), m_workerPool);
 
     m_buffer = std::move(bufferPtr);
     setMode(RenderMode::IdleMode);
@@ -64,6 +67,8 @@ void AudioEngine::deinit()
         m_buffer->setSource(nullptr);
         m_buffer = nullptr;
         m_mixer = nullptr;
+        AudioSanitizer::setupWorkerPool(nullptr);
+        m_workerPool = nullptr;
         m_inited = false;
     }
 }
@@ -30,6 +30,7 @@
 
 #include "iaudioengine.h"
 #include "mixer.h"
+#include "audioworkerpool.h"
 
 namespace muse::audio {
 class AudioBuffer;
@@ -61,6 +62,7 @@ private:
 
     sample_rate_t m_sampleRate = 0;
 
+    AudioWorkerPoolPtr m_workerPool = nullptr;
     MixerPtr m_mixer = nullptr;
     std::shared_ptr<AudioBuffer> m_buffer = nullptr;
 
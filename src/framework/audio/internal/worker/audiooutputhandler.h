@@ -63,6 +63,7 @@ public:
 
     async::Promise<bool> saveSoundTrack(const TrackSequenceId sequenceId, const io::path_t& destination,
                                         const SoundTrackFormat& format) override;
+    async::Promise<bool> saveSoundTracks(const TrackSequenceId sequenceId, const SoundTrackTargets& targets) override;
     void abortSavingAllSoundTracks() override;
 
     Progress saveSoundTrackProgress(const TrackSequenceId sequenceId) override;
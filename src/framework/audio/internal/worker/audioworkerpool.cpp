@@ -0,0 +1,231 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "audioworkerpool.h"
+
+#include <algorithm>
+#include <chrono>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__) || defined(__FreeBSD__) || defined(__APPLE__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "global/runtime.h"
+
+#include "log.h"
+
+using namespace muse;
+using namespace muse::audio;
+
+//! NOTE Long enough to pick up the jobs of the same block without parking,
+//! short enough not to take the CPU from other threads for long at the raised priority
+static constexpr std::chrono::microseconds SPIN_DURATION(50);
+
+//! NOTE More threads don't pay off, they rather compete with the rest of the app
+static constexpr size_t MAX_THREAD_COUNT = 4;
+
+//! NOTE Best effort, a real-time policy may not be allowed to the process
+static void raiseThreadPriority()
+{
+#ifdef _WIN32
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST);
+#elif defined(__linux__) || defined(__FreeBSD__) || defined(__APPLE__)
+    sched_param param;
+    param.sched_priority = sched_get_priority_min(SCHED_RR);
+    if (pthread_setschedparam(pthread_self(), SCHED_RR, &param) != 0) {
+        LOGD() << "failed to raise priority of audio worker pool thread";
+    }
+#endif
+}
+
+static size_t roundUpToPowerOfTwo(size_t value)
+{
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+AudioWorkerPool::AudioWorkerPool(size_t threadCount, size_t queueCapacity)
+{
+    const size_t capacity = roundUpToPowerOfTwo(queueCapacity < 2 ? 2 : queueCapacity);
+    m_cells = std::make_unique<Cell[]>(capacity);
+    m_mask = capacity - 1;
+    for (size_t i = 0; i < capacity; ++i) {
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    m_running = true;
+    for (size_t i = 0; i < threadCount; ++i) {
+        m_threads.emplace_back([this, i]() {
+            runtime::setThreadName("audio_pool_" + std::to_string(i));
+            raiseThreadPriority();
+            workerLoop();
+        });
+        m_threadIds.push_back(m_threads.back().get_id());
+    }
+}
+
+AudioWorkerPool::~AudioWorkerPool()
+{
+    {
+        std::lock_guard lock(m_parkMutex);
+        m_running = false;
+    }
+    m_parkCv.notify_all();
+
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+}
+
+size_t AudioWorkerPool::defaultThreadCount()
+{
+    //! NOTE The audio worker thread takes part in the work too
+    const size_t hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads > 1 ? std::min(hardwareThreads - 1, MAX_THREAD_COUNT) : 0;
+}
+
+size_t AudioWorkerPool::threadCount() const
+{
+    return m_threads.size();
+}
+
+size_t AudioWorkerPool::parkedThreadCount() const
+{
+    return m_parkedCount.load();
+}
+
+bool AudioWorkerPool::containsThread(const std::thread::id& id) const
+{
+    for (const std::thread::id& threadId : m_threadIds) {
+        if (threadId == id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Bounded MPMC queue, see https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+bool AudioWorkerPool::push(Job job, void* ctx)
+{
+    IF_ASSERT_FAILED(job) {
+        return false;
+    }
+
+    if (m_threads.empty()) {
+        return false;
+    }
+
+    Cell* cell = nullptr;
+    size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    while (true) {
+        cell = &m_cells[pos & m_mask];
+        const size_t seq = cell->sequence.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->task = Task { job, ctx };
+    cell->sequence.store(pos + 1, std::memory_order_release);
+
+    //! NOTE Pairs with the check in workerLoop: either the parking thread sees the job, or it is woken
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_parkedCount.load() > 0) {
+        std::lock_guard lock(m_parkMutex);
+        m_parkCv.notify_one();
+    }
+
+    return true;
+}
+
+bool AudioWorkerPool::tryPop(Task& task)
+{
+    Cell* cell = nullptr;
+    size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+    while (true) {
+        cell = &m_cells[pos & m_mask];
+        const size_t seq = cell->sequence.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+        if (diff == 0) {
+            if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = m_dequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    task = cell->task;
+    cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+
+    return true;
+}
+
+bool AudioWorkerPool::isEmpty() const
+{
+    const size_t pos = m_dequeuePos.load();
+    const size_t seq = m_cells[pos & m_mask].sequence.load(std::memory_order_acquire);
+    return seq != pos + 1;
+}
+
+void AudioWorkerPool::workerLoop()
+{
+    Task task;
+
+    while (m_running.load()) {
+        bool popped = false;
+        const auto spinEnd = std::chrono::steady_clock::now() + SPIN_DURATION;
+        do {
+            if (tryPop(task)) {
+                popped = true;
+                break;
+            }
+            std::this_thread::yield();
+        } while (std::chrono::steady_clock::now() < spinEnd);
+
+        if (popped) {
+            task.job(task.ctx);
+            continue;
+        }
+
+        std::unique_lock lock(m_parkMutex);
+        ++m_parkedCount;
+        m_parkCv.wait(lock, [this]() {
+            return !m_running.load() || !isEmpty();
+        });
+        --m_parkedCount;
+    }
+}
@@ -0,0 +1,88 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MUSE_AUDIO_AUDIOWORKERPOOL_H
+#define MUSE_AUDIO_AUDIOWORKERPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace muse::audio {
+//! NOTE Threads that help the audio worker thread to render a block.
+//! Unlike TaskScheduler, it is not shared with other background work,
+//! and pushing a job neither allocates nor takes a lock:
+//! the jobs are kept in a bounded lock-free queue.
+//! An idle thread spins for a short time before it parks, so that the jobs
+//! of the same block are usually picked up without a wake-up.
+class AudioWorkerPool
+{
+public:
+    using Job = void (*)(void* ctx);
+
+    explicit AudioWorkerPool(size_t threadCount, size_t queueCapacity = 256);
+    ~AudioWorkerPool();
+
+    static size_t defaultThreadCount();
+
+    size_t threadCount() const;
+    size_t parkedThreadCount() const;
+    bool containsThread(const std::thread::id& id) const;
+
+    //! NOTE Returns false if the queue is full
+    bool push(Job job, void* ctx);
+
+private:
+    struct Task {
+        Job job = nullptr;
+        void* ctx = nullptr;
+    };
+
+    struct Cell {
+        std::atomic<size_t> sequence = 0;
+        Task task;
+    };
+
+    void workerLoop();
+    bool tryPop(Task& task);
+    bool isEmpty() const;
+
+    std::unique_ptr<Cell[]> m_cells;
+    size_t m_mask = 0;
+    alignas(64) std::atomic<size_t> m_enqueuePos = 0;
+    alignas(64) std::atomic<size_t> m_dequeuePos = 0;
+
+    std::vector<std::thread> m_threads;
+    std::vector<std::thread::id> m_threadIds;
+    std::atomic<bool> m_running = false;
+
+    std::atomic<size_t> m_parkedCount = 0;
+    std::mutex m_parkMutex;
+    std::condition_variable m_parkCv;
+};
+
+using AudioWorkerPoolPtr = std::shared_ptr<AudioWorkerPool>;
+}
+
+#endif // MUSE_AUDIO_AUDIOWORKERPOOL_H
@@ -21,7 +21,7 @@
  */
 #include "mixer.h"
 
-#include "concurrency/taskscheduler.h"
+#include <thread>
 
 #include "internal/audiosanitizer.h"
 #include "internal/dsp/audiomathutils.h"
@@ -35,8 +35,8 @@ using namespace muse::async;
 
 static constexpr size_t DEFAULT_AUX_BUFFER_SIZE = 1024;
 
-Mixer::Mixer(const modularity::ContextPtr& iocCtx)
-    : muse::Injectable(iocCtx)
+Mixer::Mixer(const modularity::ContextPtr& iocCtx, AudioWorkerPoolPtr workerPool)
+    : muse::Injectable(iocCtx), m_workerPool(std::move(workerPool))
 {
     ONLY_AUDIO_WORKER_THREAD;
 
@@ -46,6 +46,11 @@ Mixer::Mixer(const modularity::ContextPtr& iocCtx)
 Mixer::~Mixer()
 {
     ONLY_AUDIO_WORKER_THREAD;
+
+    //! NOTE The helpers use the mixer, even the ones that find no job left
+    while (m_trackJobHelpers.load() > 0) {
+        std::this_thread::yield();
+    }
 }
 
 IAudioSourcePtr Mixer::mixedSource()
@@ -93,6 +98,7 @@ RetVal<MixerChannelPtr> Mixer::addChannel(const TrackId trackId, ITrackAudioInpu
     });
 
     m_trackChannels.emplace(trackId, channel);
+    m_trackBuffers.resize(m_trackChannels.size());
 
     result.val = m_trackChannels[trackId];
     result.ret = make_ret(Ret::Code::Ok);
@@ -133,6 +139,7 @@ Ret Mixer::removeChannel(const TrackId trackId)
         }
 
         m_trackChannels.erase(trackId);
+        m_trackBuffers.resize(m_trackChannels.size());
         return make_ret(Ret::Code::Ok);
     }
 
@@ -190,18 +197,70 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
         return 0;
     }
 
-    TracksData tracksData;
-    processTrackChannels(outBufferSize, samplesPerChannel, tracksData);
+    processTrackChannels(outBufferSize, samplesPerChannel, 1, useMultithreading());
+
+    return mixTrackBlock(outBuffer, samplesPerChannel, 0);
+}
+
+void Mixer::processOffline(float* outBuffer, samples_t samplesPerChannel, size_t blockCount,
+                           const ChannelOutputHandler& channelOutputHandler)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    IF_ASSERT_FAILED(!m_isIdle && blockCount > 0) {
+        return;
+    }
+
+    size_t outBufferSize = samplesPerChannel * m_audioChannelsCount;
+
+    //! NOTE The tracks don't depend on each other or on the clocks within a block,
+    //! so each track renders all of its blocks at once, all the tracks in parallel.
+    //! The blocks are then mixed one by one, just like process() does
+    processTrackChannels(outBufferSize, samplesPerChannel, blockCount, true);
+
+    if (channelOutputHandler) {
+        for (size_t i = 0; i < m_trackBuffersCount; ++i) {
+            const TrackBuffer& track = m_trackBuffers[i];
+            channelOutputHandler(track.channel->trackId(), 0, track.data.data(), track.data.size());
+        }
+    }
+
+    for (size_t block = 0; block < blockCount; ++block) {
+        for (IClockPtr clock : m_clocks) {
+            clock->forward((samplesPerChannel * 1000000) / m_sampleRate);
+        }
+
+        float* blockBuffer = outBuffer + block * outBufferSize;
+        std::fill(blockBuffer, blockBuffer + outBufferSize, 0.f);
+
+        samples_t mixedSamples = mixTrackBlock(blockBuffer, samplesPerChannel, block);
+        if (!channelOutputHandler || mixedSamples == 0) {
+            continue;
+        }
+
+        //! NOTE The aux buffers hold the processed returns until the next block is mixed
+        for (const AuxChannelInfo& aux : m_auxChannelInfoList) {
+            if (aux.receivedAudioSignal) {
+                channelOutputHandler(aux.channel->trackId(), block * outBufferSize, aux.buffer.data(), outBufferSize);
+            }
+        }
+    }
+}
+
+samples_t Mixer::mixTrackBlock(float* outBuffer, samples_t samplesPerChannel, size_t block)
+{
+    const size_t outBufferSize = samplesPerChannel * m_audioChannelsCount;
 
     prepareAuxBuffers(outBufferSize);
 
     samples_t masterChannelSampleCount = 0;
 
-    for (auto& pair : tracksData) {
-        const std::vector<float>& trackBuffer = pair.second;
+    for (size_t i = 0; i < m_trackBuffersCount; ++i) {
+        const TrackBuffer& track = m_trackBuffers[i];
+        const float* trackBuffer = track.data.data() + block * outBufferSize;
 
         bool outBufferIsSilent = false;
-        mixOutputFromChannel(outBuffer, trackBuffer.data(), samplesPerChannel, outBufferIsSilent);
+        mixOutputFromChannel(outBuffer, trackBuffer, samplesPerChannel, outBufferIsSilent);
         masterChannelSampleCount = std::max(samplesPerChannel, masterChannelSampleCount);
 
         if (!outBufferIsSilent) {
@@ -210,8 +269,8 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
             continue;
         }
 
-        const AuxSendsParams& auxSends = m_trackChannels.at(pair.first)->outputParams().auxSends;
-        writeTrackToAuxBuffers(trackBuffer.data(), auxSends, samplesPerChannel);
+        const AuxSendsParams& auxSends = track.channel->outputParams().auxSends;
+        writeTrackToAuxBuffers(trackBuffer, auxSends, samplesPerChannel);
     }
 
     if (m_masterParams.muted || masterChannelSampleCount == 0 || m_isSilence) {
@@ -231,56 +290,105 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
     return masterChannelSampleCount;
 }
 
-void Mixer::processTrackChannels(size_t outBufferSize, size_t samplesPerChannel, TracksData& outTracksData)
+void Mixer::processTrackChannels(size_t outBufferSize, samples_t samplesPerChannel, size_t blockCount, bool multithreading)
 {
-    auto processChannel = [outBufferSize, samplesPerChannel](MixerChannelPtr channel) -> std::vector<float> {
-        thread_local std::vector<float> buffer(outBufferSize, 0.f);
-        thread_local std::vector<float> silent_buffer(outBufferSize, 0.f);
+    bool filterTracks = m_isIdle && !m_tracksToProcessWhenIdle.empty();
 
-        buffer = silent_buffer;
+    m_trackBuffersCount = 0;
+    m_trackSamplesPerChannel = samplesPerChannel;
+    m_trackBlockCount = blockCount;
 
-        if (channel) {
-            channel->process(buffer.data(), samplesPerChannel);
+    const size_t trackBufferSize = outBufferSize * blockCount;
+
+    for (const auto& pair : m_trackChannels) {
+        if (filterTracks && !muse::contains(m_tracksToProcessWhenIdle, pair.second->trackId())) {
+            continue;
         }
 
-        return buffer;
-    };
+        if (pair.second->muted()) {
+            pair.second->notifyNoAudioSignal();
+            continue;
+        }
 
-    bool filterTracks = m_isIdle && !m_tracksToProcessWhenIdle.empty();
+        IF_ASSERT_FAILED(m_trackBuffersCount < m_trackBuffers.size()) {
+            break;
+        }
 
-    if (useMultithreading()) {
-        std::map<TrackId, std::future<std::vector<float> > > futures;
+        TrackBuffer& track = m_trackBuffers[m_trackBuffersCount++];
+        track.channel = pair.second.get();
 
-        for (const auto& pair : m_trackChannels) {
-            if (filterTracks && !muse::contains(m_tracksToProcessWhenIdle, pair.second->trackId())) {
-                continue;
-            }
+        //! NOTE Allocates only when the block size changes
+        if (track.data.size() != trackBufferSize) {
+            track.data.resize(trackBufferSize);
+        }
+    }
 
-            if (pair.second->muted()) {
-                pair.second->notifyNoAudioSignal();
-                continue;
-            }
+    const size_t count = m_trackBuffersCount;
 
-            std::future<std::vector<float> > future = TaskScheduler::instance()->submit(processChannel, pair.second);
-            futures.emplace(pair.first, std::move(future));
+    if (!multithreading || count < 2) {
+        for (size_t i = 0; i < count; ++i) {
+            processTrack(m_trackBuffers[i]);
         }
+        return;
+    }
+
+    m_trackJobsDone.store(0);
+    m_trackJobs.store(static_cast<uint64_t>(count) << 32, std::memory_order_release);
 
-        for (auto& pair : futures) {
-            outTracksData.emplace(pair.first, pair.second.get());
+    //! NOTE The helpers still running from the previous blocks take the jobs of this one too
+    const size_t poolSize = m_workerPool ? m_workerPool->threadCount() : 0;
+    const size_t helpers = std::min<size_t>(poolSize, count - 1);
+    for (size_t i = m_trackJobHelpers.load(); i < helpers; ++i) {
+        ++m_trackJobHelpers;
+        if (!m_workerPool->push(&Mixer::runTrackJobsHelper, this)) {
+            --m_trackJobHelpers;
+            break;
         }
-    } else {
-        for (const auto& pair : m_trackChannels) {
-            if (filterTracks && !muse::contains(m_tracksToProcessWhenIdle, pair.second->trackId())) {
-                continue;
-            }
+    }
 
-            if (pair.second->muted()) {
-                pair.second->notifyNoAudioSignal();
-                continue;
-            }
+    // the audio thread takes part in the work, so it never waits for a busy pool
+    runTrackJobs();
+    while (m_trackJobsDone.load(std::memory_order_acquire) < count) {
+        std::this_thread::yield();
+    }
+}
+
+void Mixer::runTrackJobs()
+{
+    uint64_t jobs = m_trackJobs.load(std::memory_order_acquire);
 
-            outTracksData.emplace(pair.first, processChannel(pair.second));
+    while (true) {
+        const size_t count = static_cast<size_t>(jobs >> 32);
+        const size_t next = static_cast<size_t>(jobs & 0xFFFFFFFF);
+        if (next >= count) {
+            return;
         }
+
+        if (!m_trackJobs.compare_exchange_weak(jobs, jobs + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            continue;
+        }
+
+        processTrack(m_trackBuffers[next]);
+        m_trackJobsDone.fetch_add(1, std::memory_order_release);
+
+        jobs = m_trackJobs.load(std::memory_order_acquire);
+    }
+}
+
+void Mixer::runTrackJobsHelper(void* mixer)
+{
+    Mixer* self = static_cast<Mixer*>(mixer);
+    self->runTrackJobs();
+    --self->m_trackJobHelpers;
+}
+
+void Mixer::processTrack(TrackBuffer& track)
+{
+    std::fill(track.data.begin(), track.data.end(), 0.f);
+
+    const size_t blockSize = track.data.size() / m_trackBlockCount;
+    for (size_t block = 0; block < m_trackBlockCount; ++block) {
+        track.channel->process(track.data.data() + block * blockSize, m_trackSamplesPerChannel);
     }
 }
 
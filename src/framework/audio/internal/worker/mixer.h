@@ -22,6 +22,8 @@
 #ifndef MUSE_AUDIO_MIXER_H
 #define MUSE_AUDIO_MIXER_H
 
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <map>
 
@@ -34,6 +36,7 @@
 #include "../dsp/limiter.h"
 
 #include "abstractaudiosource.h"
+#include "audioworkerpool.h"
 #include "mixerchannel.h"
 #include "iclock.h"
 
@@ -44,7 +47,7 @@ class Mixer : public AbstractAudioSource, public Injectable, public async::Async
     Inject<IAudioConfiguration> configuration = { this };
 
 public:
-    Mixer(const modularity::ContextPtr& iocCtx);
+    Mixer(const modularity::ContextPtr& iocCtx, AudioWorkerPoolPtr workerPool = nullptr);
     ~Mixer();
 
     IAudioSourcePtr mixedSource();
@@ -74,10 +77,26 @@ public:
     samples_t process(float* outBuffer, samples_t samplesPerChannel) override;
     void setIsActive(bool arg) override;
 
+    //! NOTE Receives the signal of a track channel or of an aux return before it is mixed,
+    //! offset is the position of the data in the outBuffer of processOffline
+    using ChannelOutputHandler = std::function<void (TrackId trackId, size_t offset, const float* data, size_t size)>;
+
+    //! NOTE The same as blockCount calls of process(), for rendering not in real time:
+    //! outBuffer receives the blocks one after another
+    void processOffline(float* outBuffer, samples_t samplesPerChannel, size_t blockCount,
+                        const ChannelOutputHandler& channelOutputHandler = nullptr);
+
 private:
-    using TracksData = std::map<TrackId, std::vector<float> >;
+    struct TrackBuffer {
+        MixerChannel* channel = nullptr;
+        std::vector<float> data;
+    };
 
-    void processTrackChannels(size_t outBufferSize, size_t samplesPerChannel, TracksData& outTracksData);
+    void processTrackChannels(size_t outBufferSize, samples_t samplesPerChannel, size_t blockCount, bool multithreading);
+    samples_t mixTrackBlock(float* outBuffer, samples_t samplesPerChannel, size_t block);
+    void runTrackJobs();
+    static void runTrackJobsHelper(void* mixer);
+    void processTrack(TrackBuffer& track);
     void mixOutputFromChannel(float* outBuffer, const float* inBuffer, unsigned int samplesCount, bool& outBufferIsSilent);
     void prepareAuxBuffers(size_t outBufferSize);
     void writeTrackToAuxBuffers(const float* trackBuffer, const AuxSendsParams& auxSends, samples_t samplesPerChannel);
@@ -100,9 +119,24 @@ private:
     async::Channel<AudioOutputParams> m_masterOutputParamsChanged;
     std::vector<IFxProcessorPtr> m_masterFxProcessors = {};
 
+    AudioWorkerPoolPtr m_workerPool = nullptr;
+
     std::map<TrackId, MixerChannelPtr> m_trackChannels = {};
     std::unordered_set<TrackId> m_tracksToProcessWhenIdle;
 
+    //! NOTE One per track channel, reused for every block,
+    //! so that nothing is allocated while mixing
+    std::vector<TrackBuffer> m_trackBuffers;
+    size_t m_trackBuffersCount = 0;
+    samples_t m_trackSamplesPerChannel = 0;
+    size_t m_trackBlockCount = 1;
+
+    //! NOTE The count of the jobs of the block is in the high half, the next job to take is in the low half,
+    //! so that a helper started late never takes a job by the count of another block
+    std::atomic<uint64_t> m_trackJobs = 0;
+    std::atomic<size_t> m_trackJobsDone = 0;
+    std::atomic<size_t> m_trackJobHelpers = 0;
+
     struct AuxChannelInfo {
         MixerChannelPtr channel;
         std::vector<float> buffer;
@@ -0,0 +1,252 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "audio/internal/worker/audioworkerpool.h"
+
+using namespace muse::audio;
+
+namespace muse::audio {
+class Audio_AudioWorkerPoolTest : public ::testing::Test
+{
+public:
+};
+}
+
+static constexpr std::chrono::seconds TIMEOUT(10);
+
+template<typename Predicate>
+static bool waitFor(Predicate predicate)
+{
+    const auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+static void pushUntilAccepted(AudioWorkerPool& pool, AudioWorkerPool::Job job, void* ctx)
+{
+    while (!pool.push(job, ctx)) {
+        std::this_thread::yield();
+    }
+}
+
+TEST_F(Audio_AudioWorkerPoolTest, Push_QueueFull)
+{
+    //! GIVEN A pool with one thread and room for two jobs
+    AudioWorkerPool pool(1, 2);
+
+    struct Blocker {
+        std::atomic<bool> started = false;
+        std::atomic<bool> released = false;
+    } blocker;
+
+    std::atomic<int> done = 0;
+
+    auto block = [](void* ctx) {
+        Blocker* b = static_cast<Blocker*>(ctx);
+        b->started = true;
+        while (!b->released.load()) {
+            std::this_thread::yield();
+        }
+    };
+
+    auto count = [](void* ctx) {
+        ++*static_cast<std::atomic<int>*>(ctx);
+    };
+
+    //! GIVEN The thread is busy with a job
+    ASSERT_TRUE(pool.push(block, &blocker));
+    ASSERT_TRUE(waitFor([&blocker]() { return blocker.started.load(); }));
+
+    //! DO Push more jobs than the queue holds
+    EXPECT_TRUE(pool.push(count, &done));
+    EXPECT_TRUE(pool.push(count, &done));
+
+    //! CHECK The one that doesn't fit is refused
+    EXPECT_FALSE(pool.push(count, &done));
+
+    //! CHECK The accepted ones are done once the thread is free
+    blocker.released = true;
+    EXPECT_TRUE(waitFor([&done]() { return done.load() == 2; }));
+}
+
+TEST_F(Audio_AudioWorkerPoolTest, Push_NoThreads)
+{
+    //! CHECK Without threads nobody would take the job, so it is refused
+    AudioWorkerPool pool(0);
+    EXPECT_FALSE(pool.push([](void*) {}, nullptr));
+}
+
+TEST_F(Audio_AudioWorkerPoolTest, MultipleProducers_OrderOfEachProducer)
+{
+    //! GIVEN A single consumer and several producers
+    static constexpr size_t PRODUCER_COUNT = 4;
+    static constexpr size_t JOB_COUNT = 500;
+
+    AudioWorkerPool pool(1, 64);
+
+    struct Job {
+        size_t producer = 0;
+        size_t index = 0;
+        std::vector<Job*>* log = nullptr;
+        std::atomic<size_t>* done = nullptr;
+    };
+
+    std::vector<Job*> log;
+    log.reserve(PRODUCER_COUNT * JOB_COUNT);
+    std::atomic<size_t> done = 0;
+
+    std::vector<std::vector<Job> > jobs(PRODUCER_COUNT, std::vector<Job>(JOB_COUNT));
+
+    //! DO Push the jobs from all producers at once
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < PRODUCER_COUNT; ++p) {
+        producers.emplace_back([&pool, &jobs, &log, &done, p]() {
+            for (size_t i = 0; i < JOB_COUNT; ++i) {
+                Job& job = jobs[p][i];
+                job = Job { p, i, &log, &done };
+                pushUntilAccepted(pool, [](void* ctx) {
+                    Job* j = static_cast<Job*>(ctx);
+                    j->log->push_back(j);
+                    j->done->fetch_add(1, std::memory_order_release);
+                }, &job);
+            }
+        });
+    }
+
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+
+    ASSERT_TRUE(waitFor([&done]() { return done.load(std::memory_order_acquire) == PRODUCER_COUNT * JOB_COUNT; }));
+
+    //! CHECK Every job is done once, and the jobs of each producer in the order they were pushed
+    ASSERT_EQ(log.size(), PRODUCER_COUNT * JOB_COUNT);
+
+    std::array<size_t, PRODUCER_COUNT> next = {};
+    for (const Job* job : log) {
+        EXPECT_EQ(job->index, next[job->producer]);
+        next[job->producer] = job->index + 1;
+    }
+
+    for (size_t p = 0; p < PRODUCER_COUNT; ++p) {
+        EXPECT_EQ(next[p], JOB_COUNT);
+    }
+}
+
+TEST_F(Audio_AudioWorkerPoolTest, MultipleProducersAndConsumers_EachJobOnce)
+{
+    //! GIVEN Several consumers and several producers
+    static constexpr size_t PRODUCER_COUNT = 4;
+    static constexpr size_t JOB_COUNT = 2000;
+
+    AudioWorkerPool pool(4, 64);
+
+    std::vector<std::atomic<int> > runs(PRODUCER_COUNT * JOB_COUNT);
+    std::atomic<size_t> done = 0;
+
+    struct Job {
+        std::atomic<int>* runs = nullptr;
+        std::atomic<size_t>* done = nullptr;
+    };
+
+    std::vector<Job> jobs(PRODUCER_COUNT * JOB_COUNT);
+
+    //! DO Push the jobs from all producers at once
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < PRODUCER_COUNT; ++p) {
+        producers.emplace_back([&pool, &jobs, &runs, &done, p]() {
+            for (size_t i = p * JOB_COUNT; i < (p + 1) * JOB_COUNT; ++i) {
+                jobs[i] = Job { &runs[i], &done };
+                pushUntilAccepted(pool, [](void* ctx) {
+                    Job* j = static_cast<Job*>(ctx);
+                    ++*j->runs;
+                    ++*j->done;
+                }, &jobs[i]);
+            }
+        });
+    }
+
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+
+    //! CHECK Every job is done exactly once
+    ASSERT_TRUE(waitFor([&done]() { return done.load() == PRODUCER_COUNT * JOB_COUNT; }));
+
+    for (const std::atomic<int>& r : runs) {
+        EXPECT_EQ(r.load(), 1);
+    }
+}
+
+TEST_F(Audio_AudioWorkerPoolTest, Push_WakesParkedThreads)
+{
+    //! GIVEN A pool whose threads are all parked
+    AudioWorkerPool pool(2);
+    ASSERT_TRUE(waitFor([&pool]() { return pool.parkedThreadCount() == pool.threadCount(); }));
+
+    //! DO Push jobs
+    std::atomic<int> done = 0;
+    auto count = [](void* ctx) {
+        ++*static_cast<std::atomic<int>*>(ctx);
+    };
+
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(pool.push(count, &done));
+    }
+
+    //! CHECK They are picked up without any further push
+    EXPECT_TRUE(waitFor([&done]() { return done.load() == 10; }));
+
+    //! CHECK The threads park again
+    EXPECT_TRUE(waitFor([&pool]() { return pool.parkedThreadCount() == pool.threadCount(); }));
+}
+
+TEST_F(Audio_AudioWorkerPoolTest, Shutdown_WhileParked)
+{
+    //! GIVEN A pool whose threads are all parked
+    auto pool = std::make_unique<AudioWorkerPool>(3);
+    ASSERT_TRUE(waitFor([&pool]() { return pool->parkedThreadCount() == pool->threadCount(); }));
+
+    //! DO Destroy it
+    //! CHECK The parked threads are woken and joined, the test would hang otherwise
+    std::atomic<bool> destroyed = false;
+    std::thread destroyer([&pool, &destroyed]() {
+        pool.reset();
+        destroyed = true;
+    });
+
+    EXPECT_TRUE(waitFor([&destroyed]() { return destroyed.load(); }));
+    destroyer.join();
+}
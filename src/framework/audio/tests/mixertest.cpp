@@ -0,0 +1,177 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include "global/modularity/ioc.h"
+
+#include "audio/internal/audiosanitizer.h"
+#include "audio/internal/worker/audioworkerpool.h"
+#include "audio/internal/worker/mixer.h"
+
+#include "tests/mocks/audioconfigurationmock.h"
+#include "tests/testtrackinput.h"
+
+using ::testing::NiceMock;
+using ::testing::Return;
+
+using namespace muse;
+using namespace muse::audio;
+
+static constexpr unsigned int SAMPLE_RATE = 44100;
+static constexpr audioch_t CHANNELS_COUNT = TestTrackInput::CHANNELS_COUNT;
+static constexpr samples_t SAMPLES_PER_CHANNEL = 512;
+static constexpr size_t BLOCK_COUNT = 8;
+static constexpr size_t TRACK_COUNT = 6;
+
+namespace muse::audio {
+class Audio_MixerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        AudioSanitizer::setupWorkerThread();
+
+        m_configuration = std::make_shared<NiceMock<AudioConfigurationMock> >();
+        ON_CALL(*m_configuration, minTrackCountForMultithreading()).WillByDefault(Return(2));
+        ON_CALL(*m_configuration, audioChannelsCount()).WillByDefault(Return(CHANNELS_COUNT));
+
+        modularity::globalIoc()->unregister<IAudioConfiguration>("utests");
+        modularity::globalIoc()->registerExport<IAudioConfiguration>("utests", m_configuration);
+    }
+
+    void TearDown() override
+    {
+        modularity::globalIoc()->unregister<IAudioConfiguration>("utests");
+        AudioSanitizer::setupWorkerPool(nullptr);
+    }
+
+    MixerPtr makeMixer(AudioWorkerPoolPtr workerPool = nullptr) const
+    {
+        MixerPtr mixer = std::make_shared<Mixer>(nullptr, std::move(workerPool));
+        mixer->setAudioChannelsCount(CHANNELS_COUNT);
+        mixer->setSampleRate(SAMPLE_RATE);
+
+        for (size_t i = 0; i < TRACK_COUNT; ++i) {
+            mixer->addChannel(static_cast<TrackId>(i), std::make_shared<TestTrackInput>(i));
+        }
+
+        mixer->setIsActive(true);
+
+        return mixer;
+    }
+
+    std::vector<float> processOnline(Mixer& mixer) const
+    {
+        const size_t blockSize = SAMPLES_PER_CHANNEL * CHANNELS_COUNT;
+        std::vector<float> result(blockSize * BLOCK_COUNT, 0.f);
+
+        for (size_t block = 0; block < BLOCK_COUNT; ++block) {
+            mixer.process(result.data() + block * blockSize, SAMPLES_PER_CHANNEL);
+        }
+
+        return result;
+    }
+
+    std::vector<float> processOffline(Mixer& mixer) const
+    {
+        std::vector<float> result(SAMPLES_PER_CHANNEL * CHANNELS_COUNT * BLOCK_COUNT, 0.f);
+        mixer.processOffline(result.data(), SAMPLES_PER_CHANNEL, BLOCK_COUNT);
+
+        return result;
+    }
+
+    std::shared_ptr<NiceMock<AudioConfigurationMock> > m_configuration;
+};
+}
+
+TEST_F(Audio_MixerTest, ProcessOffline_SameAsProcess)
+{
+    //! GIVEN Two mixers with the same tracks
+    MixerPtr onlineMixer = makeMixer();
+    MixerPtr offlineMixer = makeMixer();
+
+    //! DO Mix the blocks one by one with the first one and all at once with the second one
+    std::vector<float> expected = processOnline(*onlineMixer);
+    std::vector<float> actual = processOffline(*offlineMixer);
+
+    //! CHECK The output is the same, sample for sample
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(expected[i], actual[i]) << "sample: " << i;
+    }
+}
+
+TEST_F(Audio_MixerTest, ProcessOffline_SameAsProcess_WorkerPool)
+{
+    //! GIVEN Two mixers with the same tracks, which process the tracks on the worker pool
+    AudioWorkerPoolPtr workerPool = std::make_shared<AudioWorkerPool>(3);
+    AudioSanitizer::setupWorkerPool(workerPool.get());
+
+    MixerPtr onlineMixer = makeMixer(workerPool);
+    MixerPtr offlineMixer = makeMixer(workerPool);
+
+    //! DO Mix the blocks one by one with the first one and all at once with the second one
+    std::vector<float> expected = processOnline(*onlineMixer);
+    std::vector<float> actual = processOffline(*offlineMixer);
+
+    //! CHECK The output is the same, sample for sample
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(expected[i], actual[i]) << "sample: " << i;
+    }
+
+    //! CHECK And it is not silence
+    EXPECT_NE(std::count(actual.begin(), actual.end(), 0.f), static_cast<std::ptrdiff_t>(actual.size()));
+}
+
+TEST_F(Audio_MixerTest, ProcessOffline_ChannelOutput)
+{
+    //! GIVEN A mixer
+    MixerPtr mixer = makeMixer();
+
+    //! DO Mix the blocks all at once, receiving the output of the tracks
+    std::map<TrackId, std::vector<float> > tracks;
+    std::vector<float> result(SAMPLES_PER_CHANNEL * CHANNELS_COUNT * BLOCK_COUNT, 0.f);
+    mixer->processOffline(result.data(), SAMPLES_PER_CHANNEL, BLOCK_COUNT,
+                          [&tracks, &result](TrackId trackId, size_t offset, const float* data, size_t size) {
+        std::vector<float>& track = tracks[trackId];
+        track.resize(result.size(), 0.f);
+        std::copy(data, data + size, track.begin() + offset);
+    });
+
+    //! CHECK Each track is received once with all of its blocks, the same as the track renders alone
+    ASSERT_EQ(tracks.size(), TRACK_COUNT);
+    for (size_t i = 0; i < TRACK_COUNT; ++i) {
+        TestTrackInput source(i);
+        source.setSampleRate(SAMPLE_RATE);
+
+        std::vector<float> expected(result.size(), 0.f);
+        source.process(expected.data(), SAMPLES_PER_CHANNEL * BLOCK_COUNT);
+
+        EXPECT_EQ(tracks[static_cast<TrackId>(i)], expected) << "track: " << i;
+    }
+}
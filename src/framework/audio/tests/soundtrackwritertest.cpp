@@ -0,0 +1,203 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "global/modularity/ioc.h"
+
+#include "audio/audioerrors.h"
+#include "audio/internal/audiosanitizer.h"
+#include "audio/internal/soundtracks/soundtrackwriter.h"
+
+#include "tests/mocks/audioconfigurationmock.h"
+#include "tests/mocks/audioenginemock.h"
+#include "tests/testtrackinput.h"
+
+using ::testing::NiceMock;
+using ::testing::Return;
+
+using namespace muse;
+using namespace muse::audio;
+using namespace muse::audio::soundtrack;
+
+static constexpr sample_rate_t SAMPLE_RATE = 44100;
+static constexpr audioch_t CHANNELS_COUNT = TestTrackInput::CHANNELS_COUNT;
+//! NOTE Longer than the blocks rendered at once, so the tracks are written in several parts
+static constexpr msecs_t DURATION = 1000000; // 1 sec
+static constexpr samples_t SAMPLES_PER_CHANNEL = DURATION * SAMPLE_RATE / 1000000;
+static constexpr size_t TRACK_COUNT = 3;
+
+//! NOTE The size of the header written by WavEncoder
+static constexpr size_t WAV_HEADER_SIZE = 46;
+
+namespace muse::audio {
+class Audio_SoundTrackWriterTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        AudioSanitizer::setupWorkerThread();
+
+        m_configuration = std::make_shared<NiceMock<AudioConfigurationMock> >();
+        ON_CALL(*m_configuration, audioChannelsCount()).WillByDefault(Return(CHANNELS_COUNT));
+        ON_CALL(*m_configuration, renderStep()).WillByDefault(Return(512));
+
+        m_audioEngine = std::make_shared<NiceMock<AudioEngineMock> >();
+        ON_CALL(*m_audioEngine, sampleRate()).WillByDefault(Return(SAMPLE_RATE));
+
+        modularity::globalIoc()->unregister<IAudioConfiguration>("utests");
+        modularity::globalIoc()->registerExport<IAudioConfiguration>("utests", m_configuration);
+        modularity::globalIoc()->unregister<IAudioEngine>("utests");
+        modularity::globalIoc()->registerExport<IAudioEngine>("utests", m_audioEngine);
+
+        m_mixer = std::make_shared<Mixer>(nullptr);
+        m_mixer->setAudioChannelsCount(CHANNELS_COUNT);
+        m_mixer->setSampleRate(SAMPLE_RATE);
+
+        for (size_t i = 0; i < TRACK_COUNT; ++i) {
+            m_mixer->addChannel(static_cast<TrackId>(i), std::make_shared<TestTrackInput>(i));
+        }
+
+        m_dir = std::filesystem::temp_directory_path() / "muse_audio_soundtrackwritertest";
+        std::filesystem::remove_all(m_dir);
+        std::filesystem::create_directories(m_dir);
+    }
+
+    void TearDown() override
+    {
+        m_mixer = nullptr;
+
+        std::filesystem::remove_all(m_dir);
+
+        modularity::globalIoc()->unregister<IAudioConfiguration>("utests");
+        modularity::globalIoc()->unregister<IAudioEngine>("utests");
+    }
+
+    io::path_t destination(const std::string& fileName) const
+    {
+        return io::path_t((m_dir / fileName).string());
+    }
+
+    static SoundTrackFormat wavFormat(sample_rate_t sampleRate = SAMPLE_RATE)
+    {
+        return { SoundTrackType::WAV, sampleRate, CHANNELS_COUNT, 0 };
+    }
+
+    static std::vector<char> readFile(const io::path_t& path)
+    {
+        std::ifstream stream(path.toStdString(), std::ios_base::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+
+    static std::vector<float> readWavSamples(const io::path_t& path)
+    {
+        std::vector<char> data = readFile(path);
+        if (data.size() < WAV_HEADER_SIZE) {
+            return {};
+        }
+
+        std::vector<float> samples((data.size() - WAV_HEADER_SIZE) / sizeof(float));
+        std::memcpy(samples.data(), data.data() + WAV_HEADER_SIZE, samples.size() * sizeof(float));
+        return samples;
+    }
+
+    std::shared_ptr<NiceMock<AudioConfigurationMock> > m_configuration;
+    std::shared_ptr<NiceMock<AudioEngineMock> > m_audioEngine;
+    MixerPtr m_mixer;
+    std::filesystem::path m_dir;
+};
+}
+
+TEST_F(Audio_SoundTrackWriterTest, Write_SeveralTargets)
+{
+    //! GIVEN Two targets of the mix
+    SoundTrackTargets targets {
+        { destination("first.wav"), wavFormat() },
+        { destination("second.wav"), wavFormat() },
+    };
+
+    //! DO Write them
+    SoundTrackWriter writer(targets, DURATION, m_mixer, nullptr);
+    Ret ret = writer.write();
+
+    //! CHECK Both are written in full from the same render
+    ASSERT_TRUE(ret) << ret.toString();
+
+    std::vector<char> first = readFile(targets[0].destination);
+    std::vector<char> second = readFile(targets[1].destination);
+
+    EXPECT_EQ(first.size(), WAV_HEADER_SIZE + SAMPLES_PER_CHANNEL * CHANNELS_COUNT * sizeof(float));
+    EXPECT_EQ(first, second);
+}
+
+TEST_F(Audio_SoundTrackWriterTest, Write_MismatchedTargets)
+{
+    //! GIVEN Two targets with different sample rates
+    SoundTrackTargets targets {
+        { destination("first.wav"), wavFormat() },
+        { destination("second.wav"), wavFormat(48000) },
+    };
+
+    //! DO Write them
+    SoundTrackWriter writer(targets, DURATION, m_mixer, nullptr);
+    Ret ret = writer.write();
+
+    //! CHECK The write fails and nothing is written
+    EXPECT_EQ(ret.code(), static_cast<int>(Err::MismatchedSoundTrackFormats));
+    EXPECT_FALSE(std::filesystem::exists(targets[0].destination.toStdString()));
+    EXPECT_FALSE(std::filesystem::exists(targets[1].destination.toStdString()));
+}
+
+TEST_F(Audio_SoundTrackWriterTest, Write_Stems)
+{
+    //! GIVEN The mix and the stems of two tracks
+    SoundTrackTargets targets {
+        { destination("mix.wav"), wavFormat() },
+        { destination("track0.wav"), wavFormat(), 0 },
+        { destination("track2.wav"), wavFormat(), 2 },
+    };
+
+    //! DO Write them
+    SoundTrackWriter writer(targets, DURATION, m_mixer, nullptr);
+    Ret ret = writer.write();
+
+    //! CHECK Each stem is the signal of its track alone, for the whole duration
+    ASSERT_TRUE(ret) << ret.toString();
+
+    EXPECT_EQ(readWavSamples(targets[0].destination).size(), SAMPLES_PER_CHANNEL * CHANNELS_COUNT);
+
+    for (size_t i = 1; i < targets.size(); ++i) {
+        TestTrackInput source(targets[i].trackId);
+        source.setSampleRate(SAMPLE_RATE);
+
+        std::vector<float> expected(SAMPLES_PER_CHANNEL * CHANNELS_COUNT, 0.f);
+        source.process(expected.data(), SAMPLES_PER_CHANNEL);
+
+        EXPECT_EQ(readWavSamples(targets[i].destination), expected) << "track: " << targets[i].trackId;
+    }
+}
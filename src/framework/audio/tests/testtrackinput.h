@@ -0,0 +1,76 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUSE_AUDIO_TESTTRACKINPUT_H
+#define MUSE_AUDIO_TESTTRACKINPUT_H
+
+#include <cmath>
+
+#include "audio/internal/worker/track.h"
+
+namespace muse::audio {
+//! NOTE Plays a different tone on each track, so that a block mixed with the samples
+//! of another block or of another track doesn't go unnoticed
+class TestTrackInput : public ITrackAudioInput
+{
+public:
+    static constexpr audioch_t CHANNELS_COUNT = 2;
+
+    explicit TestTrackInput(size_t index)
+        : m_frequency(110.f * (index + 1)), m_amplitude(0.1f / (index + 1)) {}
+
+    bool isActive() const override { return m_isActive; }
+    void setIsActive(bool arg) override { m_isActive = arg; }
+    void setSampleRate(unsigned int sampleRate) override { m_sampleRate = sampleRate; }
+    unsigned int audioChannelsCount() const override { return CHANNELS_COUNT; }
+    async::Channel<unsigned int> audioChannelsCountChanged() const override { return m_audioChannelsCountChanged; }
+
+    samples_t process(float* buffer, samples_t samplesPerChannel) override
+    {
+        for (samples_t s = 0; s < samplesPerChannel; ++s) {
+            const float value = m_amplitude * std::sin(2.f * 3.14159265f * m_frequency * m_position / m_sampleRate);
+            for (audioch_t ch = 0; ch < CHANNELS_COUNT; ++ch) {
+                buffer[s * CHANNELS_COUNT + ch] = ch == 0 ? value : -value;
+            }
+            ++m_position;
+        }
+        return samplesPerChannel;
+    }
+
+    void seek(const msecs_t newPositionMsecs) override { m_position = newPositionMsecs * m_sampleRate / 1000; }
+    const AudioInputParams& inputParams() const override { return m_params; }
+    void applyInputParams(const AudioInputParams& requiredParams) override { m_params = requiredParams; }
+    async::Channel<AudioInputParams> inputParamsChanged() const override { return m_paramsChanged; }
+
+private:
+    float m_frequency = 0.f;
+    float m_amplitude = 0.f;
+    unsigned int m_sampleRate = 1;
+    size_t m_position = 0;
+    bool m_isActive = false;
+    AudioInputParams m_params;
+    async::Channel<unsigned int> m_audioChannelsCountChanged;
+    async::Channel<AudioInputParams> m_paramsChanged;
+};
+}
+
+#endif // MUSE_AUDIO_TESTTRACKINPUT_H
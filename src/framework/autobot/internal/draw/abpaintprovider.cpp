@@ -96,7 +96,7 @@ void AbPaintProvider::paintData(muse::draw::IPaintProviderPtr provider, const mu
         }
 
         for (const DrawText& t : d.texts) {
-            if (t.mode == DrawText::Point) {
+            if (t.mode == DrawText::Point || t.mode == DrawText::Workaround) {
                 provider->drawText(t.rect.topLeft(), t.text);
             } else {
                 provider->drawText(t.rect, t.flags, t.text);
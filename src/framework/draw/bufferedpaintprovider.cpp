@@ -44,6 +44,7 @@ void BufferedPaintProvider::beginTarget(const std::string& name)
     m_buf->name = name;
     m_stateIsUsed = false;
     m_currentStateNo = 0;
+    m_savedStates.clear();
     m_buf->states[m_currentStateNo] = DrawData::State(); // default
     beginObject("target_" + name);
     m_isActive = true;
@@ -117,6 +118,7 @@ void BufferedPaintProvider::ensureItemInit(DrawData::Item& item) const
     if (item.datas.empty()) {
         item.datas.emplace_back();                    // default data
         item.datas.back().state = m_currentStateNo;   // current state
+        item.datas.back().childrenBefore = item.chilren.size();
     }
 }
 
@@ -158,10 +160,44 @@ const DrawData::State& BufferedPaintProvider::currentState() const
     return m_buf->states.at(m_currentStateNo);
 }
 
-DrawData::Data& BufferedPaintProvider::editableData()
+DrawData::Data& BufferedPaintProvider::editableData(DataKind kind)
 {
     m_stateIsUsed = true;
-    return editableItem().datas.back();
+
+    DrawData::Item& item = editableItem();
+    DrawData::Data& data = item.datas.back();
+    if (data.empty()) {
+        data.state = m_currentStateNo;
+        data.childrenBefore = item.chilren.size();
+        return data;
+    }
+
+    // DrawDataPaint paints the paths, polygons, texts and pixmaps of a data in this order,
+    // and the children of an item after the datas that precede them.
+    // So start a new data whenever appending to the current one would change the drawing order.
+    bool newData = data.state != m_currentStateNo || data.childrenBefore != item.chilren.size();
+    switch (kind) {
+    case DataKind::Path:
+        newData = newData || !data.polygons.empty() || !data.texts.empty() || !data.pixmaps.empty();
+        break;
+    case DataKind::Polygon:
+        newData = newData || !data.texts.empty() || !data.pixmaps.empty();
+        break;
+    case DataKind::Text:
+        newData = newData || !data.pixmaps.empty();
+        break;
+    case DataKind::Pixmap:
+        break;
+    }
+
+    if (!newData) {
+        return data;
+    }
+
+    DrawData::Data& next = item.datas.emplace_back();
+    next.state = m_currentStateNo;
+    next.childrenBefore = item.chilren.size();
+    return next;
 }
 
 DrawData::State& BufferedPaintProvider::editableState()
@@ -250,10 +286,17 @@ const Brush& BufferedPaintProvider::brush() const
 
 void BufferedPaintProvider::save()
 {
+    m_savedStates.push_back(currentState());
 }
 
 void BufferedPaintProvider::restore()
 {
+    IF_ASSERT_FAILED(!m_savedStates.empty()) {
+        return;
+    }
+
+    editableState() = m_savedStates.back();
+    m_savedStates.pop_back();
 }
 
 void BufferedPaintProvider::setTransform(const Transform& transform)
@@ -278,7 +321,7 @@ void BufferedPaintProvider::drawPath(const PainterPath& path)
     } else if (st.brush.style() == BrushStyle::NoBrush) {
         mode = DrawMode::Stroke;
     }
-    editableData().paths.push_back({ path, st.pen, st.brush, mode });
+    editableData(DataKind::Path).paths.push_back({ path, st.pen, st.brush, mode });
 }
 
 void BufferedPaintProvider::drawPolygon(const PointF* points, size_t pointCount, PolygonMode mode)
@@ -287,23 +330,26 @@ void BufferedPaintProvider::drawPolygon(const PointF* points, size_t pointCount,
     for (size_t i = 0; i < pointCount; ++i) {
         pol[i] = PointF(points[i].x(), points[i].y());
     }
-    editableData().polygons.push_back(DrawPolygon { pol, mode });
+    editableData(DataKind::Polygon).polygons.push_back(DrawPolygon { pol, mode });
 }
 
 void BufferedPaintProvider::drawText(const PointF& point, const String& text)
 {
-    editableData().texts.push_back(DrawText { DrawText::Point, RectF(point, SizeF()), 0, text });
+    editableData(DataKind::Text).texts.push_back(DrawText { DrawText::Point, RectF(point, SizeF()), 0, text });
 }
 
 void BufferedPaintProvider::drawText(const RectF& rect, int flags, const String& text)
 {
-    editableData().texts.push_back(DrawText { DrawText::Rect, rect, flags, text });
+    editableData(DataKind::Text).texts.push_back(DrawText { DrawText::Rect, rect, flags, text });
 }
 
 void BufferedPaintProvider::drawTextWorkaround(const Font& f, const PointF& pos, const String& text)
 {
+    // the font is used only for this text, as with the other providers
+    Font font = currentState().font;
     setFont(f);
-    drawText(pos, text);
+    editableData(DataKind::Text).texts.push_back(DrawText { DrawText::Workaround, RectF(pos, SizeF()), 0, text });
+    setFont(font);
 }
 
 void BufferedPaintProvider::drawSymbol(const PointF& point, char32_t ucs4Code)
@@ -313,40 +359,43 @@ void BufferedPaintProvider::drawSymbol(const PointF& point, char32_t ucs4Code)
 
 void BufferedPaintProvider::drawPixmap(const PointF& p, const Pixmap& pm)
 {
-    editableData().pixmaps.push_back(DrawPixmap { DrawPixmap::Single, RectF(p, SizeF()), pm, PointF() });
+    editableData(DataKind::Pixmap).pixmaps.push_back(DrawPixmap { DrawPixmap::Single, RectF(p, SizeF()), pm, PointF() });
 }
 
 void BufferedPaintProvider::drawTiledPixmap(const RectF& rect, const Pixmap& pm, const PointF& offset)
 {
-    editableData().pixmaps.push_back(DrawPixmap { DrawPixmap::Tiled, rect, pm, offset });
+    editableData(DataKind::Pixmap).pixmaps.push_back(DrawPixmap { DrawPixmap::Tiled, rect, pm, offset });
 }
 
 #ifndef NO_QT_SUPPORT
 void BufferedPaintProvider::drawPixmap(const PointF& p, const QPixmap& pm)
 {
-    editableData().pixmaps.push_back(DrawPixmap { DrawPixmap::Single, RectF(p, SizeF()), Pixmap::fromQPixmap(pm), PointF() });
+    editableData(DataKind::Pixmap).pixmaps.push_back(DrawPixmap { DrawPixmap::Single, RectF(p, SizeF()), Pixmap::fromQPixmap(pm), PointF() });
 }
 
 void BufferedPaintProvider::drawTiledPixmap(const RectF& rect, const QPixmap& pm, const PointF& offset)
 {
-    editableData().pixmaps.push_back(DrawPixmap { DrawPixmap::Tiled, rect, Pixmap::fromQPixmap(pm), offset });
+    editableData(DataKind::Pixmap).pixmaps.push_back(DrawPixmap { DrawPixmap::Tiled, rect, Pixmap::fromQPixmap(pm), offset });
 }
 
 #endif
 
 bool BufferedPaintProvider::hasClipping() const
 {
-    return false;
+    return currentState().isClipping;
 }
 
 void BufferedPaintProvider::setClipRect(const RectF& rect)
 {
-    UNUSED(rect);
+    DrawData::State& st = editableState();
+    st.isClipping = true;
+    st.clipRect = rect;
+    st.clipTransform = st.transform;
 }
 
 void BufferedPaintProvider::setClipping(bool enable)
 {
-    UNUSED(enable);
+    editableState().isClipping = enable;
 }
 
 DrawDataPtr BufferedPaintProvider::drawData() const
@@ -358,4 +407,5 @@ void BufferedPaintProvider::clear()
 {
     m_buf = std::make_shared<DrawData>();
     m_itemLevel = -1;
+    m_savedStates.clear();
 }
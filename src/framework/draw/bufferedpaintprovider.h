@@ -94,11 +94,18 @@ public:
 
 private:
 
+    enum class DataKind {
+        Path,
+        Polygon,
+        Text,
+        Pixmap
+    };
+
     const DrawData::Item& currentItem() const;
     DrawData::Item& editableItem();
 
     const DrawData::Data& currentData() const;
-    DrawData::Data& editableData();
+    DrawData::Data& editableData(DataKind kind);
 
     const DrawData::State& currentState() const;
     DrawData::State& editableState();
@@ -109,6 +116,7 @@ private:
     int m_itemLevel = -1;
     bool m_stateIsUsed = false;
     int m_currentStateNo = 0;
+    std::vector<DrawData::State> m_savedStates;
     bool m_isActive = false;
     DrawObjectsLogger* m_drawObjectsLogger = nullptr;
 };
@@ -30,7 +30,8 @@ namespace muse::draw {
 QImagePainterProvider::QImagePainterProvider(std::shared_ptr<Pixmap> px)
     : QPainterProvider(new QPainter()), m_px(px)
 {
-    m_image = Pixmap::toQPixmap(*px.get()).toImage();
+    //! NOTE Only QImage is used here, unlike QPixmap it can be painted on any thread
+    m_image = Pixmap::toQImage(*px.get()).convertToFormat(QImage::Format_ARGB32_Premultiplied);
     m_painter->begin(&m_image);
 }
 
@@ -42,7 +43,7 @@ QImagePainterProvider::~QImagePainterProvider()
 bool QImagePainterProvider::endTarget(bool endDraw)
 {
     UNUSED(endDraw)
-    * m_px = Pixmap::fromQPixmap(QPixmap::fromImage(m_image));
+    * m_px = Pixmap::fromQImage(m_image);
     return true;
 }
 
@@ -26,7 +26,7 @@ std::shared_ptr<Pixmap> QImageProvider::createPixmap(int w, int h, int dpm, cons
     image.setDotsPerMeterY(dpm);
     image.fill(color.toQColor());
 
-    return std::make_shared<Pixmap>(Pixmap::fromQPixmap(QPixmap::fromImage(image)));
+    return std::make_shared<Pixmap>(Pixmap::fromQImage(image));
 }
 
 Pixmap QImageProvider::scaled(const Pixmap& origin, const Size& s) const
@@ -46,6 +46,6 @@ void QImageProvider::saveAsPng(std::shared_ptr<Pixmap> px, io::IODevice* device)
 {
     QBuffer buf;
     buf.open(QIODevice::WriteOnly);
-    Pixmap::toQPixmap(*px).save(&buf, FILE_FORMAT);
+    Pixmap::toQImage(*px).save(&buf, FILE_FORMAT);
     device->write(buf.data());
 }
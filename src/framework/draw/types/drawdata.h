@@ -76,11 +76,12 @@ struct DrawText {
     enum Mode {
         Undefined = 0,
         Point,
-        Rect
+        Rect,
+        Workaround  // Painted with Painter::drawTextWorkaround and the font of the state
     };
 
     Mode mode = Mode::Undefined;
-    RectF rect;     // If mode is Point when use topLeft point
+    RectF rect;     // If mode is Point or Workaround when use topLeft point
     int flags = 0;
     String text;
     bool operator==(const DrawText& o) const
@@ -115,11 +116,15 @@ struct DrawData
         Transform transform;
         bool isAntialiasing = false;
         CompositionMode compositionMode = CompositionMode::SourceOver;
+        bool isClipping = false;
+        RectF clipRect;
+        Transform clipTransform; // The transform at the time the clip rect was set
 
         bool operator==(const State& o) const
         {
             return pen == o.pen && brush == o.brush && font == o.font && transform == o.transform
-                   && isAntialiasing == o.isAntialiasing && compositionMode == o.compositionMode;
+                   && isAntialiasing == o.isAntialiasing && compositionMode == o.compositionMode
+                   && isClipping == o.isClipping && clipRect == o.clipRect && clipTransform == o.clipTransform;
         }
 
         bool operator!=(const State& o) const { return !this->operator==(o); }
@@ -127,6 +132,7 @@ struct DrawData
 
     struct Data {
         int state = 0;
+        size_t childrenBefore = 0; // The children of the item that are painted before this data
 
         std::vector<DrawPath> paths;
         std::vector<DrawPolygon> polygons;
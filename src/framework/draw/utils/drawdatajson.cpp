@@ -183,6 +183,10 @@ static JsonObject toObj(const DrawData::State& st)
     obj["isAntialiasing"] = st.isAntialiasing;
     obj["transform"] = toArr(st.transform);
     obj["compositionMode"] = static_cast<int>(st.compositionMode);
+    if (st.isClipping) {
+        obj["clipRect"] = toArr(st.clipRect);
+        obj["clipTransform"] = toArr(st.clipTransform);
+    }
     return obj;
 }
 
@@ -194,6 +198,11 @@ static void fromObj(const JsonObject& obj, DrawData::State& st)
     st.isAntialiasing = obj["isAntialiasing"].toBool();
     fromArr(obj["transform"].toArray(), st.transform);
     st.compositionMode = static_cast<CompositionMode>(obj["compositionMode"].toInt());
+    st.isClipping = obj.contains("clipRect");
+    if (st.isClipping) {
+        fromArr(obj["clipRect"].toArray(), st.clipRect);
+        fromArr(obj["clipTransform"].toArray(), st.clipTransform);
+    }
 }
 
 static JsonObject toObj(const PainterPath& path)
@@ -315,6 +324,8 @@ static JsonObject toObj(const DrawText& text)
     JsonObject o;
     if (text.mode == DrawText::Point) {
         o["point"] = toArr(text.rect.topLeft());
+    } else if (text.mode == DrawText::Workaround) {
+        o["workaround"] = toArr(text.rect.topLeft());
     } else {
         o["rect"] = toArr(text.rect);
     }
@@ -330,6 +341,11 @@ static void fromObj(const JsonObject& obj, DrawText& text)
         fromArr(obj["point"].toArray(), point);
         text.mode = DrawText::Point;
         text.rect = RectF(point, SizeF());
+    } else if (obj.contains("workaround")) {
+        PointF point;
+        fromArr(obj["workaround"].toArray(), point);
+        text.mode = DrawText::Workaround;
+        text.rect = RectF(point, SizeF());
     } else {
         fromArr(obj["rect"].toArray(), text.rect);
         text.mode = DrawText::Rect;
@@ -411,6 +427,9 @@ static JsonObject toObj(const DrawData::Item& obj)
 
         JsonObject dataObj;
         dataObj["state"] = data.state;
+        if (data.childrenBefore > 0) {
+            dataObj["childrenBefore"] = static_cast<int>(data.childrenBefore);
+        }
         if (!data.paths.empty()) {
             dataObj["paths"] = toArr(data.paths);
         }
@@ -446,6 +465,7 @@ static void fromObj(const JsonObject& objObj, DrawData::Item& obj)
         const JsonObject dataObj = datasArr.at(j).toObject();
         DrawData::Data data;
         data.state = dataObj["state"].toInt();
+        data.childrenBefore = static_cast<size_t>(dataObj["childrenBefore"].toInt());
         if (dataObj.contains("paths")) {
             fromArr(dataObj.value("paths").toArray(), data.paths);
         }
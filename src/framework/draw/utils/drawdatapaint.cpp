@@ -29,8 +29,13 @@ using namespace muse::draw;
 static void drawItem(IPaintProviderPtr& provider, const DrawData::Item& item, const std::map<int, DrawData::State>& states,
                      const Color& overlay)
 {
-    // first draw obj itself
+    size_t childIdx = 0;
     for (const DrawData::Data& d : item.datas) {
+        // first draw the children that were painted before this data
+        for (; childIdx < d.childrenBefore && childIdx < item.chilren.size(); ++childIdx) {
+            drawItem(provider, item.chilren.at(childIdx), states, overlay);
+        }
+
         DrawData::State st = states.at(d.state);
         if (overlay.isValid()) {
             st.pen.setColor(overlay);
@@ -40,16 +45,29 @@ static void drawItem(IPaintProviderPtr& provider, const DrawData::Item& item, co
         provider->setPen(st.pen);
         provider->setBrush(st.brush);
         provider->setFont(st.font);
-        provider->setTransform(st.transform);
         provider->setAntialiasing(st.isAntialiasing);
         provider->setCompositionMode(st.compositionMode);
 
+        // the clip rect is in the coordinates it was set in
+        if (st.isClipping) {
+            provider->setTransform(st.clipTransform);
+            provider->setClipRect(st.clipRect);
+        } else {
+            provider->setClipping(false);
+        }
+        provider->setTransform(st.transform);
+
         for (const DrawPath& path : d.paths) {
             provider->setPen(path.pen);
             provider->setBrush(path.brush);
             provider->drawPath(path.path);
         }
 
+        if (!d.paths.empty()) {
+            provider->setPen(st.pen);
+            provider->setBrush(st.brush);
+        }
+
         for (const DrawPolygon& pl : d.polygons) {
             if (pl.polygon.empty()) {
                 continue;
@@ -60,6 +78,8 @@ static void drawItem(IPaintProviderPtr& provider, const DrawData::Item& item, co
         for (const DrawText& t : d.texts) {
             if (t.mode == DrawText::Point) {
                 provider->drawText(t.rect.topLeft(), t.text);
+            } else if (t.mode == DrawText::Workaround) {
+                provider->drawTextWorkaround(st.font, t.rect.topLeft(), t.text);
             } else {
                 provider->drawText(t.rect, t.flags, t.text);
             }
@@ -74,9 +94,9 @@ static void drawItem(IPaintProviderPtr& provider, const DrawData::Item& item, co
         }
     }
 
-    // second draw chilren
-    for (const DrawData::Item& ch : item.chilren) {
-        drawItem(provider, ch, states, overlay);
+    // then draw the remaining chilren
+    for (; childIdx < item.chilren.size(); ++childIdx) {
+        drawItem(provider, item.chilren.at(childIdx), states, overlay);
     }
 }
 
@@ -187,6 +187,41 @@ ByteArray IODevice::readAll()
     return read(size());
 }
 
+ByteArray IODevice::readShared(size_t len)
+{
+    IF_ASSERT_FAILED(isOpenModeReadable()) {
+        return ByteArray();
+    }
+
+    IF_ASSERT_FAILED(m_pos <= size()) {
+        return ByteArray();
+    }
+
+    size_t left = size() - m_pos;
+    if (left < len) {
+        len = left;
+    }
+
+    if (len == 0) {
+        return ByteArray();
+    }
+
+    ByteArray result = sharedData(m_pos, len);
+
+    m_pos += len;
+
+    return result;
+}
+
+ByteArray IODevice::sharedData(size_t pos, size_t len) const
+{
+    const uint8_t* d = rawData();
+    IF_ASSERT_FAILED(d) {
+        return ByteArray();
+    }
+    return ByteArray(d + pos, len);
+}
+
 const uint8_t* IODevice::readData()
 {
     IF_ASSERT_FAILED(isOpen()) {
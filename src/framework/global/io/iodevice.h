@@ -57,6 +57,8 @@ public:
     size_t read(uint8_t* data, size_t len);
     ByteArray read(size_t count);
     ByteArray readAll();
+    //! NOTE Not copied if the device can share its data (e.g. a memory-mapped file)
+    ByteArray readShared(size_t count);
 
     const uint8_t* readData();
 
@@ -81,6 +83,7 @@ protected:
     virtual const uint8_t* rawData() const = 0;
     virtual bool resizeData(size_t size) = 0;
     virtual size_t writeData(const uint8_t* data, size_t len) = 0;
+    virtual ByteArray sharedData(size_t pos, size_t len) const;
 
     bool isOpenModeReadable() const;
     bool isOpenModeWriteable() const;
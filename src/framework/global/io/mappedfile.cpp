@@ -0,0 +1,197 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "mappedfile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "file.h"
+#include "ioretcodes.h"
+
+#include "log.h"
+
+using namespace muse;
+using namespace muse::io;
+
+struct MappedFile::Mapping
+{
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    bool mapped = false;
+
+    //! NOTE Used if the file can't be mapped
+    ByteArray fallback;
+
+    ~Mapping()
+    {
+        if (!mapped) {
+            return;
+        }
+
+#ifdef _WIN32
+        UnmapViewOfFile(data);
+#else
+        munmap(const_cast<uint8_t*>(data), size);
+#endif
+    }
+
+    bool map(const path_t& filePath)
+    {
+#ifdef _WIN32
+        const std::wstring path = filePath.toString().toStdWString();
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                  nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0) {
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping) {
+            return false;
+        }
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        // the view keeps the mapping alive
+        CloseHandle(mapping);
+        if (!view) {
+            return false;
+        }
+
+        data = static_cast<const uint8_t*>(view);
+        size = static_cast<size_t>(fileSize.QuadPart);
+#else
+        int fd = ::open(filePath.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+            ::close(fd);
+            return false;
+        }
+
+        void* addr = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        // the mapping stays valid after the descriptor is closed
+        ::close(fd);
+        if (addr == MAP_FAILED) {
+            return false;
+        }
+
+        // the file is usually parsed from the beginning to the end
+        ::madvise(addr, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+
+        data = static_cast<const uint8_t*>(addr);
+        size = static_cast<size_t>(st.st_size);
+#endif
+        mapped = true;
+        return true;
+    }
+};
+
+MappedFile::MappedFile(const path_t& filePath)
+    : m_filePath(filePath)
+{
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+path_t MappedFile::filePath() const
+{
+    return m_filePath;
+}
+
+bool MappedFile::isMapped() const
+{
+    return m_mapping && m_mapping->mapped;
+}
+
+bool MappedFile::doOpen(OpenMode m)
+{
+    if (m != IODevice::ReadOnly) {
+        NOT_SUPPORTED << "mapped files are read only";
+        setError(int(Err::FSWriteError), "Mapped files can only be opened in the read-only mode");
+        return false;
+    }
+
+    std::shared_ptr<Mapping> mapping = std::make_shared<Mapping>();
+    if (!mapping->map(m_filePath)) {
+        // empty files can't be mapped, also the file may be not in the local file system
+        Ret ret = File::readFile(m_filePath, mapping->fallback);
+        if (!ret) {
+            setError(ret.code(), ret.text());
+            return false;
+        }
+
+        mapping->data = mapping->fallback.constData();
+        mapping->size = mapping->fallback.size();
+    }
+
+    m_mapping = mapping;
+
+    return true;
+}
+
+size_t MappedFile::dataSize() const
+{
+    return m_mapping ? m_mapping->size : 0;
+}
+
+const uint8_t* MappedFile::rawData() const
+{
+    return m_mapping ? m_mapping->data : nullptr;
+}
+
+bool MappedFile::resizeData(size_t)
+{
+    return false;
+}
+
+size_t MappedFile::writeData(const uint8_t*, size_t)
+{
+    return 0;
+}
+
+ByteArray MappedFile::sharedData(size_t pos, size_t len) const
+{
+    IF_ASSERT_FAILED(m_mapping) {
+        return ByteArray();
+    }
+
+    return ByteArray::fromRawData(m_mapping->data + pos, len, m_mapping);
+}
@@ -0,0 +1,65 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MUSE_IO_MAPPEDFILE_H
+#define MUSE_IO_MAPPEDFILE_H
+
+#include <memory>
+
+#include "iodevice.h"
+#include "path.h"
+
+namespace muse::io {
+//! NOTE Read-only file, mapped into memory instead of being read.
+//! The data returned by readShared refers to the mapping and keeps it alive,
+//! so reading it does not copy the file contents.
+//! If the file can't be mapped, it is read as usual.
+class MappedFile : public IODevice
+{
+public:
+
+    MappedFile() = default;
+    MappedFile(const path_t& filePath);
+    ~MappedFile();
+
+    path_t filePath() const;
+
+    bool isMapped() const;
+
+protected:
+
+    bool doOpen(OpenMode m) override;
+    size_t dataSize() const override;
+    const uint8_t* rawData() const override;
+    bool resizeData(size_t size) override;
+    size_t writeData(const uint8_t* data, size_t len) override;
+    ByteArray sharedData(size_t pos, size_t len) const override;
+
+private:
+
+    struct Mapping;
+
+    path_t m_filePath;
+    std::shared_ptr<Mapping> m_mapping;
+};
+}
+
+#endif // MUSE_IO_MAPPEDFILE_H
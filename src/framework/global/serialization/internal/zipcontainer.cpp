@@ -21,11 +21,14 @@
  */
 #include "zipcontainer.h"
 
+#include <algorithm>
+#include <atomic>
 #include <ctime>
 #include <cstring>
 #include <zlib.h>
 
 #include "global/io/dir.h"
+#include "global/concurrency/taskscheduler.h"
 
 #include "log.h"
 
@@ -384,7 +387,23 @@ struct ZipContainer::Impl {
         Directory, File, Symlink
     };
 
+    struct Entry {
+        EntryType type = File;
+        std::string fileName;
+        ByteArray contents;
+        std::tm modified;
+        ByteArray data;
+        bool compressed = false;
+    };
+
+    bool deferredCompression = false;
+    std::vector<Entry> pendingEntries;
+
     void addEntry(EntryType type, const std::string& fileName, const ByteArray& contents);
+    void compressEntry(Entry& entry) const;
+    void compressPendingEntries();
+    void flushPendingEntries();
+    void writeEntry(const Entry& entry);
     bool writeToDevice(const uint8_t* data, size_t len);
     bool writeToDevice(const ByteArray& data);
 
@@ -393,6 +412,7 @@ struct ZipContainer::Impl {
 
     void scanFiles();
     ZipContainer::FileInfo fillFileInfo(size_t index) const;
+    bool seekFileData(const std::string& fileName, int& compressionMethod, size_t& compressedSize, size_t& uncompressedSize);
 };
 
 void ZipContainer::Impl::scanFiles()
@@ -561,11 +581,30 @@ ZipContainer::FileInfo ZipContainer::Impl::fillFileInfo(size_t index) const
 
 void ZipContainer::Impl::addEntry(EntryType type, const std::string& fileName, const ByteArray& contents)
 {
-    if (!(device->isOpen() || device->open(IODevice::WriteOnly))) {
-        status = ZipContainer::FileOpenError;
+    Entry entry;
+    entry.type = type;
+    entry.fileName = fileName;
+    entry.contents = contents;
+
+    std::time_t t = std::time(0);   // get time now
+#ifdef WIN32
+    localtime_s(&entry.modified, &t);
+#else
+    localtime_r(&t, &entry.modified);
+#endif
+
+    if (deferredCompression) {
+        pendingEntries.push_back(std::move(entry));
         return;
     }
-    device->seek(start_of_directory);
+
+    compressEntry(entry);
+    writeEntry(entry);
+}
+
+void ZipContainer::Impl::compressEntry(Entry& entry) const
+{
+    const ByteArray& contents = entry.contents;
 
     // don't compress small files
     ZipContainer::CompressionPolicy compression = compressionPolicy;
@@ -577,6 +616,102 @@ void ZipContainer::Impl::addEntry(EntryType type, const std::string& fileName, c
         }
     }
 
+    entry.compressed = compression == ZipContainer::AlwaysCompress;
+    if (!entry.compressed) {
+        entry.data = contents;
+        return;
+    }
+
+    ByteArray& data = entry.data;
+    ulong len = (ulong)contents.size();
+    // shamelessly copied form zlib
+    len += (len >> 12) + (len >> 14) + 11;
+    int res;
+    do {
+        data.resize(len);
+        res = deflate((uint8_t*)data.data(), &len, (const uint8_t*)contents.constData(), (ulong)contents.size());
+
+        switch (res) {
+        case Z_OK:
+            data.resize(len);
+            break;
+        case Z_MEM_ERROR:
+            LOGW("Zip: Z_MEM_ERROR: Not enough memory to compress file, skipping");
+            data.resize(0);
+            break;
+        case Z_BUF_ERROR:
+            len *= 2;
+            break;
+        }
+    } while (res == Z_BUF_ERROR);
+}
+
+void ZipContainer::Impl::compressPendingEntries()
+{
+    const size_t count = pendingEntries.size();
+    if (count < 2) {
+        for (Entry& entry : pendingEntries) {
+            compressEntry(entry);
+        }
+        return;
+    }
+
+    struct Jobs {
+        std::atomic<size_t> next = 0;
+        std::atomic<size_t> done = 0;
+    };
+
+    //! NOTE The jobs state is shared with the helper tasks, because a helper
+    //! may start only after all the work is done and the caller has returned
+    std::shared_ptr<Jobs> jobs = std::make_shared<Jobs>();
+    Entry* entries = pendingEntries.data();
+    auto runJobs = [this, jobs, entries, count]() {
+        for (size_t idx = jobs->next++; idx < count; idx = jobs->next++) {
+            compressEntry(entries[idx]);
+            ++jobs->done;
+        }
+    };
+
+    TaskScheduler* scheduler = TaskScheduler::instance();
+    const size_t helpers = std::min<size_t>(scheduler->threadPoolSize(), count - 1);
+    for (size_t i = 0; i < helpers; ++i) {
+        scheduler->push(runJobs);
+    }
+
+    // the calling thread takes part in the work, so it never waits for a busy pool
+    runJobs();
+    while (jobs->done.load() < count) {
+        std::this_thread::yield();
+    }
+}
+
+void ZipContainer::Impl::flushPendingEntries()
+{
+    if (pendingEntries.empty()) {
+        return;
+    }
+
+    compressPendingEntries();
+
+    // written in the order they were added, so the output doesn't depend on the compression order
+    for (const Entry& entry : pendingEntries) {
+        writeEntry(entry);
+    }
+
+    pendingEntries.clear();
+}
+
+void ZipContainer::Impl::writeEntry(const Entry& entry)
+{
+    if (!(device->isOpen() || device->open(IODevice::WriteOnly))) {
+        status = ZipContainer::FileOpenError;
+        return;
+    }
+    device->seek(start_of_directory);
+
+    const ByteArray& contents = entry.contents;
+    const ByteArray& data = entry.data;
+
     FileHeader header;
     std::memset(&header.h, 0, sizeof(CentralFileHeader));
     writeUInt(header.h.signature, 0x02014b50);
@@ -584,39 +719,9 @@ void ZipContainer::Impl::addEntry(EntryType type, const std::string& fileName, c
     writeUShort(header.h.version_needed, ZIP_VERSION);
     writeUInt(header.h.uncompressed_size, (uint)contents.size());
 
-    std::time_t t = std::time(0);   // get time now
-    std::tm now;
-#ifdef WIN32
-    localtime_s(&now, &t);
-#else
-    localtime_r(&t, &now);
-#endif
-    writeMSDosDate(header.h.last_mod_file, now);
-    ByteArray data = contents;
-    if (compression == ZipContainer::AlwaysCompress) {
+    writeMSDosDate(header.h.last_mod_file, entry.modified);
+    if (entry.compressed) {
         writeUShort(header.h.compression_method, CompressionMethodDeflated);
-
-        ulong len = (ulong)contents.size();
-        // shamelessly copied form zlib
-        len += (len >> 12) + (len >> 14) + 11;
-        int res;
-        do {
-            data.resize(len);
-            res = deflate((uint8_t*)data.data(), &len, (const uint8_t*)contents.constData(), (ulong)contents.size());
-
-            switch (res) {
-            case Z_OK:
-                data.resize(len);
-                break;
-            case Z_MEM_ERROR:
-                LOGW("Zip: Z_MEM_ERROR: Not enough memory to compress file, skipping");
-                data.resize(0);
-                break;
-            case Z_BUF_ERROR:
-                len *= 2;
-                break;
-            }
-        } while (res == Z_BUF_ERROR);
     }
 // TODO add a check if data.size() > contents.size().  Then try to store the original and revert the compression method to be uncompressed
     writeUInt(header.h.compressed_size, (uint)data.size());
@@ -629,7 +734,7 @@ void ZipContainer::Impl::addEntry(EntryType type, const std::string& fileName, c
     writeUShort(header.h.general_purpose_bits, general_purpose_bits);
 
     //const bool inUtf8 = (general_purpose_bits & Utf8Names) != 0;
-    header.file_name = ByteArray(fileName.c_str(), fileName.size());
+    header.file_name = ByteArray(entry.fileName.c_str(), entry.fileName.size());
     if (header.file_name.size() > 0xffff) {
         LOGW("Zip: Filename is too long, chopping it to 65535 bytes");
         header.file_name = header.file_name.left(0xffff); // ### don't break the utf-8 sequence, if any
@@ -649,7 +754,7 @@ void ZipContainer::Impl::addEntry(EntryType type, const std::string& fileName, c
                     | UnixFileAttributes::ExeUser
                     | UnixFileAttributes::ReadGroup
                     | UnixFileAttributes::ReadOther;
-    switch (type) {
+    switch (entry.type) {
     case Symlink:
         mode |= UnixFileAttributes::SymLink;
         break;
@@ -735,90 +840,143 @@ bool ZipContainer::fileExists(const std::string& fileName) const
     return false;
 }
 
-ByteArray ZipContainer::fileData(const std::string& fileName) const
+bool ZipContainer::Impl::seekFileData(const std::string& fileName, int& compressionMethod, size_t& compressedSize,
+                                      size_t& uncompressedSize)
 {
-    p->scanFiles();
+    scanFiles();
 
     ByteArray fileNameBa = ByteArray::fromRawData(fileName.c_str(), fileName.size());
 
     size_t i;
-    for (i = 0; i < p->fileHeaders.size(); ++i) {
-        if (p->fileHeaders.at(i).file_name == fileNameBa) {
+    for (i = 0; i < fileHeaders.size(); ++i) {
+        if (fileHeaders.at(i).file_name == fileNameBa) {
             break;
         }
     }
 
-    if (i == p->fileHeaders.size()) {
-        return ByteArray();
+    if (i == fileHeaders.size()) {
+        return false;
     }
 
-    FileHeader header = p->fileHeaders.at(i);
+    FileHeader header = fileHeaders.at(i);
 
     ushort version_needed = readUShort(header.h.version_needed);
     if (version_needed > ZIP_VERSION) {
         LOGW("Zip: .ZIP specification version %d implementation is needed to extract the data.", version_needed);
-        return ByteArray();
+        return false;
     }
 
     ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
-    int compressed_size = readUInt(header.h.compressed_size);
-    int uncompressed_size = readUInt(header.h.uncompressed_size);
+    compressedSize = readUInt(header.h.compressed_size);
+    uncompressedSize = readUInt(header.h.uncompressed_size);
     int start = readUInt(header.h.offset_local_header);
 
-    p->device->seek(start);
+    device->seek(start);
     LocalFileHeader lh;
-    p->device->read((uint8_t*)&lh, sizeof(LocalFileHeader));
+    device->read((uint8_t*)&lh, sizeof(LocalFileHeader));
     uint skip = readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
-    p->device->seek(p->device->pos() + skip);
+    device->seek(device->pos() + skip);
 
-    int compression_method = readUShort(lh.compression_method);
+    compressionMethod = readUShort(lh.compression_method);
 
     if ((general_purpose_bits & Encrypted) != 0) {
         LOGW("Zip: Unsupported encryption method is needed to extract the data.");
+        return false;
+    }
+
+    return true;
+}
+
+static ByteArray inflateData(const uint8_t* compressed, size_t compressedSize, size_t uncompressedSize)
+{
+    ByteArray baunzip;
+    ulong len = std::max<ulong>(uncompressedSize, 1);
+    int res;
+    do {
+        baunzip.resize(len);
+        res = inflate((uint8_t*)baunzip.data(), &len, compressed, compressedSize);
+
+        switch (res) {
+        case Z_OK:
+            if ((size_t)len != baunzip.size()) {
+                baunzip.resize(len);
+            }
+            break;
+        case Z_MEM_ERROR:
+            LOGW("Zip: Z_MEM_ERROR: Not enough memory");
+            break;
+        case Z_BUF_ERROR:
+            len *= 2;
+            break;
+        case Z_DATA_ERROR:
+            LOGW("Zip: Z_DATA_ERROR: Input data is corrupted");
+            break;
+        }
+    } while (res == Z_BUF_ERROR);
+    return baunzip;
+}
+
+ByteArray ZipContainer::fileData(const std::string& fileName, bool shared) const
+{
+    int compression_method = 0;
+    size_t compressed_size = 0;
+    size_t uncompressed_size = 0;
+    if (!p->seekFileData(fileName, compression_method, compressed_size, uncompressed_size)) {
         return ByteArray();
     }
 
-    ByteArray compressed = p->device->read(compressed_size);
     if (compression_method == CompressionMethodStored) {
         // no compression
-        compressed.truncate(uncompressed_size);
-        return compressed;
+        ByteArray stored = shared ? p->device->readShared(compressed_size) : p->device->read(compressed_size);
+        if (stored.size() > uncompressed_size) {
+            stored.truncate(uncompressed_size);
+        }
+        return stored;
     } else if (compression_method == CompressionMethodDeflated) {
-        // Deflate
-        //qDebug("compressed=%d", compressed.size());
-        compressed.truncate(compressed_size);
-        ByteArray baunzip;
-        ulong len = std::max(uncompressed_size,  1);
-        int res;
-        do {
-            baunzip.resize(len);
-            res = inflate((uint8_t*)baunzip.data(), &len,
-                          (const uint8_t*)compressed.constData(), compressed_size);
-
-            switch (res) {
-            case Z_OK:
-                if ((size_t)len != baunzip.size()) {
-                    baunzip.resize(len);
-                }
-                break;
-            case Z_MEM_ERROR:
-                LOGW("Zip: Z_MEM_ERROR: Not enough memory");
-                break;
-            case Z_BUF_ERROR:
-                len *= 2;
-                break;
-            case Z_DATA_ERROR:
-                LOGW("Zip: Z_DATA_ERROR: Input data is corrupted");
-                break;
-            }
-        } while (res == Z_BUF_ERROR);
-        return baunzip;
+        // Deflate, straight from the device data without copying the compressed data
+        const size_t available = p->device->size() - p->device->pos();
+        const uint8_t* compressed = p->device->readData() + p->device->pos();
+        return inflateData(compressed, std::min(compressed_size, available), uncompressed_size);
     }
 
     LOGW("Zip: Unsupported compression method %d is needed to extract the data.", compression_method);
     return ByteArray();
 }
 
+ZipContainer::RawFileData ZipContainer::rawFileData(const std::string& fileName) const
+{
+    RawFileData raw;
+
+    int compression_method = 0;
+    size_t compressed_size = 0;
+    if (!p->seekFileData(fileName, compression_method, compressed_size, raw.size)) {
+        return raw;
+    }
+
+    if (compression_method != CompressionMethodStored && compression_method != CompressionMethodDeflated) {
+        LOGW("Zip: Unsupported compression method %d is needed to extract the data.", compression_method);
+        return raw;
+    }
+
+    raw.deflated = compression_method == CompressionMethodDeflated;
+    raw.data = p->device->read(compressed_size);
+
+    return raw;
+}
+
+ByteArray ZipContainer::uncompressedData(const RawFileData& raw)
+{
+    if (!raw.deflated) {
+        ByteArray stored = raw.data;
+        if (stored.size() > raw.size) {
+            stored.truncate(raw.size);
+        }
+        return stored;
+    }
+
+    return inflateData(raw.data.constData(), raw.data.size(), raw.size);
+}
+
 ZipContainer::Status ZipContainer::status() const
 {
     return p->status;
@@ -834,6 +992,24 @@ ZipContainer::CompressionPolicy ZipContainer::compressionPolicy() const
     return p->compressionPolicy;
 }
 
+void ZipContainer::setDeferredCompression(bool deferred)
+{
+    if (!deferred) {
+        p->flushPendingEntries();
+    }
+    p->deferredCompression = deferred;
+}
+
+bool ZipContainer::deferredCompression() const
+{
+    return p->deferredCompression;
+}
+
+void ZipContainer::flush()
+{
+    p->flushPendingEntries();
+}
+
 void ZipContainer::addFile(const std::string& fileName, const ByteArray& data)
 {
     p->addEntry(Impl::File, Dir::fromNativeSeparators(fileName).toStdString(), data);
@@ -851,6 +1027,9 @@ void ZipContainer::addDirectory(const std::string& dirName)
 
 void ZipContainer::close()
 {
+    // opens the device for writing if nothing has been written yet
+    p->flushPendingEntries();
+
     if (!(p->device->openMode() & IODevice::WriteOnly)) {
         p->device->close();
         return;
@@ -64,7 +64,18 @@ public:
     int count() const;
 
     bool fileExists(const std::string& fileName) const;
-    ByteArray fileData(const std::string& fileName) const;
+    ByteArray fileData(const std::string& fileName, bool shared = false) const;
+
+    //! NOTE The data of a file as it is stored in the container, to be uncompressed later
+    struct RawFileData
+    {
+        ByteArray data;
+        bool deflated = false;
+        size_t size = 0;    // uncompressed
+    };
+
+    RawFileData rawFileData(const std::string& fileName) const;
+    static ByteArray uncompressedData(const RawFileData& raw);
 
     // Write
     enum CompressionPolicy {
@@ -76,6 +87,12 @@ public:
     void setCompressionPolicy(CompressionPolicy policy);
     CompressionPolicy compressionPolicy() const;
 
+    //! NOTE When deferred, added entries are kept in memory and compressed concurrently on flush or close,
+    //! then written in the order they were added, so the output is the same as without deferring
+    void setDeferredCompression(bool deferred);
+    bool deferredCompression() const;
+    void flush();
+
     void addFile(const std::string& fileName, const ByteArray& data);
     void addDirectory(const std::string& dirName);
 
@@ -20,6 +20,10 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 #include "textstream.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
 #include <sstream>
 
 using namespace muse;
@@ -55,59 +59,67 @@ TextStream& TextStream::operator<<(char ch)
     return *this;
 }
 
+//! NOTE The numbers are formatted in place, as it is done for every value written to a file.
+//! The output is the same as with std::stringstream (the classic locale).
+template<typename T>
+static void formatInteger(TextStream& stream, T val)
+{
+    char buf[24];
+    const std::to_chars_result r = std::to_chars(buf, buf + sizeof(buf), val);
+    stream << AsciiStringView(buf, static_cast<size_t>(r.ptr - buf));
+}
+
 TextStream& TextStream::operator<<(int val)
 {
-    std::stringstream ss;
-    ss << val;
-    write(ss.str().c_str(), ss.str().size());
+    formatInteger(*this, val);
     return *this;
 }
 
 TextStream& TextStream::operator<<(unsigned int val)
 {
-    std::stringstream ss;
-    ss << val;
-    write(ss.str().c_str(), ss.str().size());
+    formatInteger(*this, val);
     return *this;
 }
 
 TextStream& TextStream::operator<<(double val)
 {
+#ifdef __cpp_lib_to_chars
+    // the same as the default stream precision (printf %g)
+    char buf[32];
+    const std::to_chars_result r = std::to_chars(buf, buf + sizeof(buf), val, std::chars_format::general, 6);
+    if (r.ec == std::errc()) {
+        write(buf, static_cast<size_t>(r.ptr - buf));
+        return *this;
+    }
+#endif
     std::stringstream ss;
     ss << val;
-    write(ss.str().c_str(), ss.str().size());
+    std::string str = ss.str();
+    write(str.c_str(), str.size());
     return *this;
 }
 
 TextStream& TextStream::operator<<(signed long int val)
 {
-    std::stringstream ss;
-    ss << val;
-    write(ss.str().c_str(), ss.str().size());
+    formatInteger(*this, val);
     return *this;
 }
 
 TextStream& TextStream::operator<<(unsigned long int val)
 {
-    std::stringstream ss;
-    ss << val;
-    write(ss.str().c_str(), ss.str().size());
+    formatInteger(*this, val);
     return *this;
 }
 
 TextStream& TextStream::operator<<(signed long long val)
 {
-    std::stringstream ss;
-    ss << val;
-    write(ss.str().c_str(), ss.str().size());
+    formatInteger(*this, val);
     return *this;
 }
 
 TextStream& TextStream::operator<<(unsigned long long val)
 {
-    std::stringstream ss;
-    ss << val;
-    write(ss.str().c_str(), ss.str().size());
+    formatInteger(*this, val);
     return *this;
 }
 
@@ -152,6 +164,17 @@ TextStream& TextStream::operator<<(const String& s)
     return *this;
 }
 
+void TextStream::writeSpaces(size_t count)
+{
+    static constexpr char SPACES[] = "                                ";
+    static constexpr size_t MAX = sizeof(SPACES) - 1;
+    while (count > 0) {
+        const size_t n = std::min(count, MAX);
+        write(SPACES, n);
+        count -= n;
+    }
+}
+
 void TextStream::write(const char* ch, size_t len)
 {
     m_buf.push_back(reinterpret_cast<const uint8_t*>(ch), len);
@@ -56,6 +56,8 @@ public:
     TextStream& operator<<(const AsciiStringView& s);
     TextStream& operator<<(const String& s);
 
+    void writeSpaces(size_t count);
+
 #ifndef NO_QT_SUPPORT
     TextStream& operator<<(const QString& s);
 #endif
@@ -21,6 +21,8 @@
  */
 #include "xmlstreamwriter.h"
 
+#include <cstring>
+
 #include "global/containers.h"
 #include "textstream.h"
 
@@ -34,9 +36,47 @@ struct XmlStreamWriter::Impl {
 
     void putLevel()
     {
-        size_t level = stack.size();
-        for (size_t i = 0; i < level * 2; ++i) {
-            stream << ' ';
+        stream.writeSpaces(stack.size() * 2);
+    }
+
+    //! NOTE Escapes straight into the stream, the same way as String::toXmlEscaped,
+    //! the special characters are all ASCII, so the UTF-8 bytes can be escaped as they are
+    void putEscaped(const char* s, size_t len)
+    {
+        size_t runStart = 0;
+        for (size_t i = 0; i < len; ++i) {
+            const char c = s[i];
+            const char* esc = nullptr;
+            switch (c) {
+            case '<': esc = "&lt;";
+                break;
+            case '>': esc = "&gt;";
+                break;
+            case '&': esc = "&amp;";
+                break;
+            case '\"': esc = "&quot;";
+                break;
+            default:
+                // ignore invalid characters in xml 1.0
+                if (static_cast<unsigned char>(c) < 0x20 && c != 0x09 && c != 0x0A && c != 0x0D) {
+                    esc = "";
+                }
+                break;
+            }
+
+            if (!esc) {
+                continue;
+            }
+
+            if (i > runStart) {
+                stream << AsciiStringView(s + runStart, i - runStart);
+            }
+            stream << esc;
+            runStart = i + 1;
+        }
+
+        if (len > runStart) {
+            stream << AsciiStringView(s + runStart, len - runStart);
         }
     }
 };
@@ -114,12 +154,18 @@ void XmlStreamWriter::writeValue(const Value& v)
         break;
     case 7: m_impl->stream << std::get<double>(v);
         break;
-    case 8: m_impl->stream << escapeString(AsciiStringView(std::get<const char*>(v)));
-        break;
-    case 9: m_impl->stream << escapeString(std::get<AsciiStringView>(v));
-        break;
-    case 10: m_impl->stream << escapeString(std::get<String>(v));
-        break;
+    case 8: {
+        const char* str = std::get<const char*>(v);
+        m_impl->putEscaped(str, str ? std::strlen(str) : 0);
+    } break;
+    case 9: {
+        const AsciiStringView& str = std::get<AsciiStringView>(v);
+        m_impl->putEscaped(str.ascii(), str.size());
+    } break;
+    case 10: {
+        const ByteArray utf8 = std::get<String>(v).toUtf8();
+        m_impl->putEscaped(utf8.constChar(), utf8.size());
+    } break;
     default:
         LOGI() << "index: " << v.index();
         UNREACHABLE;
@@ -102,9 +102,20 @@ bool ZipReader::fileExists(const std::string& fileName) const
     return m_impl->zip->fileExists(fileName);
 }
 
-ByteArray ZipReader::fileData(const std::string& fileName) const
+ByteArray ZipReader::fileData(const std::string& fileName, bool shared) const
 {
-    return m_impl->zip->fileData(fileName);
+    return m_impl->zip->fileData(fileName, shared);
+}
+
+ZipReader::RawFileData ZipReader::rawFileData(const std::string& fileName) const
+{
+    ZipContainer::RawFileData raw = m_impl->zip->rawFileData(fileName);
+    return { raw.data, raw.deflated, raw.size };
+}
+
+ByteArray ZipReader::uncompressedData(const RawFileData& raw)
+{
+    return ZipContainer::uncompressedData({ raw.data, raw.deflated, raw.size });
 }
 
 // ===========================
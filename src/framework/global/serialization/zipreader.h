@@ -54,7 +54,21 @@ public:
 
     std::vector<FileInfo> fileInfoList() const;
     bool fileExists(const std::string& fileName) const;
-    ByteArray fileData(const std::string& fileName) const;
+    //! NOTE If shared, stored (not compressed) files may refer to the device data instead of being copied,
+    //! e.g. to the mapping of a memory-mapped file
+    ByteArray fileData(const std::string& fileName, bool shared = false) const;
+
+    //! NOTE The data of a file as it is stored in the zip, e.g. to be kept
+    //! after the file is closed and uncompressed only when it is needed
+    struct RawFileData
+    {
+        ByteArray data;
+        bool deflated = false;
+        size_t size = 0;    // uncompressed
+    };
+
+    RawFileData rawFileData(const std::string& fileName) const;
+    static ByteArray uncompressedData(const RawFileData& raw);
 
 private:
     struct Impl;
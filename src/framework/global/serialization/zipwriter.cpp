@@ -89,6 +89,11 @@ bool ZipWriter::hasError() const
     return m_impl->zip->status() != ZipContainer::NoError;
 }
 
+void ZipWriter::setDeferredCompression(bool deferred)
+{
+    m_impl->zip->setDeferredCompression(deferred);
+}
+
 void ZipWriter::addFile(const std::string& fileName, const ByteArray& data)
 {
     m_impl->zip->addFile(fileName, data);
@@ -37,6 +37,9 @@ public:
     void close();
     bool hasError() const;
 
+    //! NOTE Compress entries concurrently on close instead of one by one in addFile
+    void setDeferredCompression(bool deferred);
+
     void addFile(const std::string& fileName, const ByteArray& data);
 
 private:
@@ -24,6 +24,7 @@
 #include <cstring>
 
 #include "io/file.h"
+#include "io/mappedfile.h"
 
 using namespace muse;
 using namespace muse::io;
@@ -207,3 +208,37 @@ TEST_F(Global_IO_FileTests, FileTests_Exists_Append)
         EXPECT_EQ(refba, data);
     }
 }
+
+TEST_F(Global_IO_FileTests, FileTests_Mapped_ReadShared)
+{
+    path_t filePath("FileTests_Mapped_ReadShared.txt");
+    std::string ref = "Hello World!";
+    createFile(filePath, ref);
+    ByteArray refba(reinterpret_cast<const uint8_t*>(ref.c_str()), ref.size());
+
+    ByteArray shared;
+    {
+        //! GIVEN Mapped file
+        MappedFile f(filePath);
+
+        //! DO Open file
+        EXPECT_TRUE(f.open(IODevice::ReadOnly));
+        EXPECT_EQ(f.size(), ref.size());
+
+        //! DO Read a part
+        f.seek(6);
+        EXPECT_EQ(f.readShared(5), ByteArray("World"));
+
+        //! DO Read all without copying
+        f.seek(0);
+        shared = f.readShared(f.size());
+        EXPECT_EQ(shared, refba);
+    }
+
+    //! CHECK The data is still valid after the file is closed
+    EXPECT_EQ(shared, refba);
+
+    //! CHECK Modification makes a copy
+    shared.push_back('!');
+    EXPECT_EQ(shared, ByteArray("Hello World!!"));
+}
@@ -827,6 +827,30 @@ TEST_F(Global_Types_StringTests, AsciiString_ToDouble)
     }
 }
 
+TEST_F(Global_Types_StringTests, AsciiString_ToDouble_SameAsStrtod)
+{
+    //! GIVEN Numbers written the way they are stored in the files, and a few that are not
+    std::vector<std::string> numbers = { "0", "-0", "0.5", ".5", "1.", "-1.25", "12.3456", "0.1", "-0.3",
+                                         "123456789012345", "1234567890123456", "0.000000000000001",
+                                         "1e5", "+3", " 4", "0x10", "3.4.5" };
+    for (int i = -2000; i <= 2000; ++i) {
+        numbers.push_back(std::to_string(i / 7.0));
+        numbers.push_back(std::to_string(i * 0.001));
+    }
+
+    for (const std::string& n : numbers) {
+        //! DO
+        bool ok = false;
+        double v = AsciiStringView(n.c_str()).toDouble(&ok);
+
+        //! CHECK The result is bitwise the same as with strtod
+        char* end = nullptr;
+        double expected = std::strtod(n.c_str(), &end);
+        EXPECT_EQ(std::memcmp(&v, &expected, sizeof(double)), 0) << n;
+        EXPECT_EQ(ok, end != n.c_str()) << n;
+    }
+}
+
 TEST_F(Global_Types_StringTests, String_DecodeXmlEntities)
 {
     String ret = String::decodeXmlEntities(u"gg &#33; &#37;&#37;");
@@ -0,0 +1,85 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "io/buffer.h"
+#include "serialization/zipwriter.h"
+#include "serialization/zipreader.h"
+
+using namespace muse;
+using namespace muse::io;
+
+class Global_Ser_ZipTests : public ::testing::Test
+{
+public:
+};
+
+static ByteArray makeData(size_t size, char seed)
+{
+    ByteArray data;
+    data.resize(size);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<uint8_t>(seed + (i % 13) * (i % 7));
+    }
+    return data;
+}
+
+TEST_F(Global_Ser_ZipTests, Zip_DeferredCompression)
+{
+    //! GIVEN Some files, small ones are stored and big ones are compressed
+    std::vector<std::pair<std::string, ByteArray> > files = {
+        { "a.txt", ByteArray("small") },
+        { "dir/b.xml", makeData(100000, 'b') },
+        { "dir/c.xml", makeData(5000, 'c') },
+        { "d.bin", ByteArray() },
+        { "e.xml", makeData(300000, 'e') },
+    };
+
+    //! DO Write them with the deferred compression
+    ByteArray zipData;
+    {
+        Buffer buf(&zipData);
+        buf.open(IODevice::WriteOnly);
+
+        ZipWriter zip(&buf);
+        zip.setDeferredCompression(true);
+        for (const auto& f : files) {
+            zip.addFile(f.first, f.second);
+        }
+        zip.close();
+        EXPECT_FALSE(zip.hasError());
+    }
+
+    //! CHECK The files are in the order they were added, with the same data
+    Buffer buf(&zipData);
+    buf.open(IODevice::ReadOnly);
+
+    ZipReader zip(&buf);
+    std::vector<ZipReader::FileInfo> infos = zip.fileInfoList();
+    ASSERT_EQ(infos.size(), files.size());
+    for (size_t i = 0; i < files.size(); ++i) {
+        EXPECT_EQ(infos.at(i).filePath, io::path_t(files.at(i).first));
+        EXPECT_EQ(zip.fileData(files.at(i).first), files.at(i).second);
+    }
+}
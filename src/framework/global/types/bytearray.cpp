@@ -70,6 +70,13 @@ ByteArray ByteArray::fromRawData(const char* data, size_t size)
     return fromRawData(reinterpret_cast<const uint8_t*>(data), size);
 }
 
+ByteArray ByteArray::fromRawData(const uint8_t* data, size_t size, const std::shared_ptr<const void>& owner)
+{
+    ByteArray ba = fromRawData(data, size);
+    ba.m_rawOwner = owner;
+    return ba;
+}
+
 uint8_t* ByteArray::data()
 {
     detach();
@@ -106,10 +113,12 @@ void ByteArray::detach()
     }
 
     if (m_raw.data) {
-        m_data->resize(m_raw.size + 1);
+        // copies of a raw array share the empty m_data, so it must not be reused
+        m_data = std::make_shared<Data>(m_raw.size + 1);
         m_data->operator [](m_raw.size) = 0;
         std::memcpy(m_data->data(), m_raw.data, m_raw.size);
         m_raw.data = nullptr;
+        m_rawOwner.reset();
         return;
     }
 
@@ -191,8 +200,8 @@ void ByteArray::push_back(const uint8_t* b, size_t len)
     Data& data = *m_data.get();
     data.resize(nsize + 1);
     data[nsize] = 0;
-    for (size_t i = 0; i < len; ++i) {
-        data[start + i] = b[i];
+    if (len > 0) {
+        std::memcpy(data.data() + start, b, len);
     }
 }
 
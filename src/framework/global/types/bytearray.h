@@ -44,6 +44,8 @@ public:
     //! NOTE Not coped!!!
     static ByteArray fromRawData(const uint8_t* data, size_t size);
     static ByteArray fromRawData(const char* data, size_t size);
+    //! NOTE Not copied, the owner of the data is kept alive while the array refers to it
+    static ByteArray fromRawData(const uint8_t* data, size_t size, const std::shared_ptr<const void>& owner);
 
     bool operator==(const ByteArray& other) const;
     bool operator!=(const ByteArray& other) const { return !operator==(other); }
@@ -105,6 +107,7 @@ private:
 
     std::shared_ptr<Data> m_data;
     RawData m_raw;
+    std::shared_ptr<const void> m_rawOwner;
 };
 }
 
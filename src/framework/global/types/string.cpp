@@ -22,6 +22,7 @@
 #include "string.h"
 
 #include <algorithm>
+#include <charconv>
 #include <cstring>
 #include <cstdlib>
 #include <locale>
@@ -40,14 +41,84 @@ constexpr unsigned char U16BE_BOM[] = { 254, 255 };
 
 // Helpers
 
+//! NOTE Plain numbers, as they are written to the files, are parsed without strtol/strtod,
+//! which need the locale to be switched to "C" (slow, and not thread safe).
+//! Anything else goes the old way, so the results are the same.
+static bool toInt_fast(const char* str, size_t len, int base, long int& v)
+{
+    if (base < 2) {
+        return false;
+    }
+    int i = 0;
+    const std::from_chars_result r = std::from_chars(str, str + len, i, base);
+    if (r.ec != std::errc() || r.ptr != str + len) {
+        return false;
+    }
+    v = i;
+    return true;
+}
+
+static bool toDouble_fast(const char* str, size_t len, double& v)
+{
+    // the digits fit into the double mantissa and the powers of ten are exact,
+    // so the division is correctly rounded, just like strtod
+    static constexpr double POW10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15 };
+    static constexpr int MAX_DIGITS = 15;
+
+    size_t i = 0;
+    const bool negative = len > 0 && str[0] == '-';
+    if (negative) {
+        ++i;
+    }
+
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int fracDigits = 0;
+    bool dot = false;
+    for (; i < len; ++i) {
+        const char c = str[i];
+        if (c >= '0' && c <= '9') {
+            if (++digits > MAX_DIGITS) {
+                return false;
+            }
+            mantissa = mantissa * 10 + static_cast<uint64_t>(c - '0');
+            if (dot) {
+                ++fracDigits;
+            }
+        } else if (c == '.' && !dot) {
+            dot = true;
+        } else {
+            return false;
+        }
+    }
+
+    if (digits == 0) {
+        return false;
+    }
+
+    v = static_cast<double>(mantissa) / POW10[fracDigits];
+    if (negative) {
+        v = -v;
+    }
+    return true;
+}
+
 static long int toInt_helper(const char* str, bool* ok, int base)
 {
-    if (!str || std::strlen(str) == 0) {
+    const size_t len = str ? std::strlen(str) : 0;
+    if (len == 0) {
         if (ok) {
             *ok = false;
         }
         return 0;
     }
+    long int fast = 0;
+    if (toInt_fast(str, len, base, fast)) {
+        if (ok) {
+            *ok = true;
+        }
+        return fast;
+    }
     const char* currentLoc = setlocale(LC_NUMERIC, "C");
     char* end = nullptr;
     long int v = static_cast<int>(std::strtol(str, &end, base));
@@ -68,6 +139,13 @@ static double toDouble_helper(const char* str, bool* ok)
     if (!str) {
         return 0.0;
     }
+    double fast = 0.0;
+    if (toDouble_fast(str, std::strlen(str), fast)) {
+        if (ok) {
+            *ok = true;
+        }
+        return fast;
+    }
     const char* currentLoc = setlocale(LC_NUMERIC, "C");
     char* end = nullptr;
     double v = std::strtod(str, &end);
@@ -1236,7 +1314,26 @@ String String::toXmlEscaped(const String& s)
     escaped.reserve(s.size());
     for (size_t i = 0; i < s.size(); ++i) {
         char16_t c = s.at(i).unicode();
-        escaped += toXmlEscaped(c);
+        switch (c) {
+        case u'<':
+            escaped += u"&lt;";
+            break;
+        case u'>':
+            escaped += u"&gt;";
+            break;
+        case u'&':
+            escaped += u"&amp;";
+            break;
+        case u'\"':
+            escaped += u"&quot;";
+            break;
+        default:
+            // ignore invalid characters in xml 1.0
+            if (!(c < 0x0020 && c != 0x0009 && c != 0x000A && c != 0x000D)) {
+                escaped += c;
+            }
+            break;
+        }
     }
     return escaped;
 }
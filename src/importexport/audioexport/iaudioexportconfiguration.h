@@ -42,6 +42,10 @@ public:
     virtual int exportSampleRate() const = 0;
     virtual void setExportSampleRate(int rate) = 0;
     virtual const std::vector<int>& availableSampleRates() const = 0;
+
+    //! NOTE Whether the track of each instrument is exported next to the mix, in its own file
+    virtual bool exportStems() const = 0;
+    virtual void setExportStems(bool exportStems) = 0;
 };
 }
 
@@ -21,12 +21,15 @@
  */
 #include "abstractaudiowriter.h"
 
+#include <set>
+
 #include <QApplication>
 #include <QFile>
 #include <QFileInfo>
 #include <QThread>
 
 #include "global/containers.h"
+#include "global/io/path.h"
 #include "audio/iaudiooutput.h"
 
 #include "log.h"
@@ -94,7 +97,7 @@ Ret AbstractAudioWriter::doWriteAndWait(INotationPtr notation,
 {
     //!Note Temporary workaround, since QIODevice is the alias for QIODevice, which falls with SIGSEGV
     //!     on any call from background thread. Once we have our own implementation of QIODevice
-    //!     we can pass QIODevice directly into IPlayback::IAudioOutput::saveSoundTrack
+    //!     we can pass QIODevice directly into IPlayback::IAudioOutput::saveSoundTracks
 
     QString path = QString::fromStdString(destinationDevice.meta("file_path"));
     IF_ASSERT_FAILED(!path.isEmpty()) {
@@ -112,8 +115,10 @@ Ret AbstractAudioWriter::doWriteAndWait(INotationPtr notation,
         playbackController()->setNotation(globalContext()->currentNotation());
     });
 
+    const SoundTrackTargets targets = soundTrackTargets(muse::io::path_t(path), format, stems(notation));
+
     playback()->sequenceIdList()
-    .onResolve(this, [this, path, &format](const TrackSequenceIdList& sequenceIdList) {
+    .onResolve(this, [this, path, targets](const TrackSequenceIdList& sequenceIdList) {
         m_progress.started.notify();
 
         for (const TrackSequenceId sequenceId : sequenceIdList) {
@@ -122,7 +127,7 @@ Ret AbstractAudioWriter::doWriteAndWait(INotationPtr notation,
                 m_progress.progressChanged.send(current, total, title);
             });
 
-            playback()->audioOutput()->saveSoundTrack(sequenceId, muse::io::path_t(path), std::move(format))
+            playback()->audioOutput()->saveSoundTracks(sequenceId, targets)
             .onResolve(this, [this, path](const bool /*result*/) {
                 LOGD() << "Successfully saved sound track by path: " << path;
                 m_writeRet = muse::make_ok();
@@ -148,6 +153,62 @@ Ret AbstractAudioWriter::doWriteAndWait(INotationPtr notation,
     return m_writeRet;
 }
 
+SoundTrackTargets AbstractAudioWriter::soundTrackTargets(const io::path_t& path, const SoundTrackFormat& format,
+                                                         const std::vector<Stem>& stems)
+{
+    SoundTrackTargets targets { { path, format } };
+
+    const io::path_t basePath = io::dirpath(path) + "/" + io::completeBasename(path);
+    const std::string suffix = io::suffix(path);
+
+    std::set<std::string> fileNames;
+
+    for (const Stem& stem : stems) {
+        std::string fileName = io::escapeFileName(stem.name).toStdString();
+
+        //! NOTE Parts may have the same name
+        for (int i = 2; muse::contains(fileNames, fileName); ++i) {
+            fileName = io::escapeFileName(stem.name).toStdString() + "-" + std::to_string(i);
+        }
+
+        fileNames.insert(fileName);
+        targets.push_back({ basePath + "-" + fileName + "." + suffix, format, stem.trackId });
+    }
+
+    return targets;
+}
+
+std::vector<AbstractAudioWriter::Stem> AbstractAudioWriter::stems(INotationPtr notation) const
+{
+    if (!configuration()->exportStems()) {
+        return {};
+    }
+
+    std::vector<Stem> result;
+
+    for (const auto& pair : playbackController()->instrumentTrackIdMap()) {
+        //! NOTE Skips the metronome and the parts not in the notation
+        const Part* part = notation->parts()->part(pair.first.partId);
+        if (!part) {
+            continue;
+        }
+
+        std::string name = part->partName().toStdString();
+        if (pair.first.instrumentId != part->instrument()->id()) {
+            name += "-" + pair.first.instrumentId.toStdString();
+        }
+
+        result.push_back({ pair.second, name });
+    }
+
+    //! NOTE The map is not ordered, but the names of the files given to the parts of the same name must not change
+    std::sort(result.begin(), result.end(), [](const Stem& s1, const Stem& s2) {
+        return s1.trackId < s2.trackId;
+    });
+
+    return result;
+}
+
 INotationWriter::UnitType AbstractAudioWriter::unitTypeFromOptions(const Options& options) const
 {
     std::vector<UnitType> supported = supportedUnitTypes();
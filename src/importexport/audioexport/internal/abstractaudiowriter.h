@@ -51,11 +51,21 @@ public:
     muse::Progress* progress() override;
     void abort() override;
 
+    struct Stem {
+        muse::audio::TrackId trackId = muse::audio::INVALID_TRACK_ID;
+        std::string name;
+    };
+
+    //! NOTE The mix at the path and, next to it, a file of each stem named after it
+    static muse::audio::SoundTrackTargets soundTrackTargets(const muse::io::path_t& path, const muse::audio::SoundTrackFormat& format,
+                                                            const std::vector<Stem>& stems);
+
 protected:
     muse::Ret doWriteAndWait(notation::INotationPtr notation, muse::io::IODevice& dstDevice, const muse::audio::SoundTrackFormat& format);
 
 private:
     UnitType unitTypeFromOptions(const Options& options) const;
+    std::vector<Stem> stems(notation::INotationPtr notation) const;
 
     muse::Progress m_progress;
     bool m_isCompleted = false;
@@ -39,6 +39,9 @@ public:
     void setExportSampleRate(int rate) override;
     const std::vector<int>& availableSampleRates() const override;
 
+    bool exportStems() const override;
+    void setExportStems(bool exportStems) override;
+
 private:
     std::optional<int> m_exportMp3BitrateOverride = std::nullopt;
 };
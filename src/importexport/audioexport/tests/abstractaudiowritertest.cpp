@@ -0,0 +1,81 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "importexport/audioexport/internal/abstractaudiowriter.h"
+
+using namespace muse;
+using namespace muse::audio;
+using namespace mu::iex::audioexport;
+
+namespace mu::iex::audioexport {
+class AudioExport_AbstractAudioWriterTest : public ::testing::Test
+{
+public:
+};
+}
+
+static const SoundTrackFormat FORMAT { SoundTrackType::WAV, 44100, 2, 0 };
+
+TEST_F(AudioExport_AbstractAudioWriterTest, SoundTrackTargets_NoStems)
+{
+    //! DO Make the targets of an export without stems
+    SoundTrackTargets targets = AbstractAudioWriter::soundTrackTargets("/some dir/score.wav", FORMAT, {});
+
+    //! CHECK Only the mix is written, to the given path
+    ASSERT_EQ(targets.size(), 1);
+    EXPECT_EQ(targets[0].destination, io::path_t("/some dir/score.wav"));
+    EXPECT_EQ(targets[0].format, FORMAT);
+    EXPECT_EQ(targets[0].trackId, INVALID_TRACK_ID);
+}
+
+TEST_F(AudioExport_AbstractAudioWriterTest, SoundTrackTargets_Stems)
+{
+    //! GIVEN The stems of three tracks, two of them of parts with the same name
+    std::vector<AbstractAudioWriter::Stem> stems {
+        { 1, "Violin" },
+        { 2, "Piano: left/right" },
+        { 3, "Violin" },
+    };
+
+    //! DO Make the targets of an export with the stems
+    SoundTrackTargets targets = AbstractAudioWriter::soundTrackTargets("/some dir/score.wav", FORMAT, stems);
+
+    //! CHECK The mix is written to the given path, each stem next to it, in the same format, to a file of its own
+    ASSERT_EQ(targets.size(), 4);
+    EXPECT_EQ(targets[0].destination, io::path_t("/some dir/score.wav"));
+    EXPECT_EQ(targets[0].trackId, INVALID_TRACK_ID);
+
+    EXPECT_EQ(targets[1].destination, io::path_t("/some dir/score-Violin.wav"));
+    EXPECT_EQ(targets[1].trackId, 1);
+
+    EXPECT_EQ(targets[2].destination, io::path_t("/some dir/score-Piano__left_right.wav"));
+    EXPECT_EQ(targets[2].trackId, 2);
+
+    EXPECT_EQ(targets[3].destination, io::path_t("/some dir/score-Violin-2.wav"));
+    EXPECT_EQ(targets[3].trackId, 3);
+
+    for (const SoundTrackTarget& target : targets) {
+        EXPECT_EQ(target.format, FORMAT);
+    }
+}
@@ -152,6 +152,12 @@ public:
     virtual bool warnGuitarBends() const = 0;
     virtual void setWarnGuitarBends(bool value) = 0;
 
+    virtual bool isLazyPageLayoutEnabled() const = 0;
+    virtual void setIsLazyPageLayoutEnabled(bool enabled) = 0;
+
+    virtual bool isLazyImageLoadingEnabled() const = 0;
+    virtual void setIsLazyImageLoadingEnabled(bool enabled) = 0;
+
     virtual int delayBetweenNotesInRealTimeModeMilliseconds() const = 0;
     virtual void setDelayBetweenNotesInRealTimeModeMilliseconds(int delayMs) = 0;
 
@@ -119,7 +119,8 @@ void MasterNotation::initAfterSettingScore(const MasterScore* score)
 
     TRACEFUNC;
 
-    score->changesChannel().onReceive(this, [this](const ScoreChangesRange&) {
+    score->changesChannel().onReceive(this, [this](const ScoreChangesRange& range) {
+        invalidateExcerptsLayout(range);
         updateExcerpts();
     });
 
@@ -567,6 +568,7 @@ void MasterNotation::resetExcerpt(IExcerptNotationPtr excerptNotation)
     undoStack()->prepareChanges();
 
     mu::engraving::Excerpt* oldExcerpt = get_impl(excerptNotation)->excerpt();
+    m_laidOutExcerptScores.erase(oldExcerpt->excerptScore());
     masterScore()->deleteExcerpt(oldExcerpt);
 
     mu::engraving::Excerpt* newExcerpt = new mu::engraving::Excerpt(*oldExcerpt, false);
@@ -619,8 +621,17 @@ void MasterNotation::setExcerptIsOpen(const INotationPtr excerptNotation, bool o
 
     excerptNotation->setIsOpen(open);
 
-    if (open) {
-        excerptNotation->elements()->msScore()->doLayout();
+    Score* score = excerptNotation->elements()->msScore();
+    if (!open) {
+        // laid out while it was open
+        m_laidOutExcerptScores.insert(score);
+        return;
+    }
+
+    // only the parts touched by edits since the last layout need it now
+    if (!muse::contains(m_laidOutExcerptScores, static_cast<const Score*>(score))) {
+        score->doLayout();
+        m_laidOutExcerptScores.insert(score);
     }
 }
 
@@ -631,6 +642,16 @@ void MasterNotation::doSetExcerpts(const ExcerptNotationList& excerpts)
     m_excerpts = excerpts;
     m_excerptsChanged.notify();
 
+    // forget the layouts of removed excerpts
+    std::unordered_set<const Score*> laidOut;
+    for (const IExcerptNotationPtr& excerptNotation : m_excerpts) {
+        const Excerpt* excerpt = get_impl(excerptNotation)->excerpt();
+        if (excerpt && muse::contains(m_laidOutExcerptScores, static_cast<const Score*>(excerpt->excerptScore()))) {
+            laidOut.insert(excerpt->excerptScore());
+        }
+    }
+    m_laidOutExcerptScores = std::move(laidOut);
+
     static_cast<MasterNotationParts*>(m_parts.get())->setExcerpts(excerpts);
 
     updatePotentialExcerpts();
@@ -773,6 +794,93 @@ INotationPlaybackPtr MasterNotation::playback() const
     return m_notationPlayback;
 }
 
+static bool changesAllExcerpts(const ScoreChangesRange& range)
+{
+    static const std::unordered_set<ElementType> SYSTEM_TYPES {
+        ElementType::SCORE,
+        ElementType::MEASURE,
+        ElementType::HBOX,
+        ElementType::VBOX,
+        ElementType::TBOX,
+        ElementType::FBOX,
+        ElementType::TIMESIG,
+        ElementType::TEMPO_TEXT,
+        ElementType::GRADUAL_TEMPO_CHANGE,
+        ElementType::GRADUAL_TEMPO_CHANGE_SEGMENT,
+        ElementType::LAYOUT_BREAK,
+        ElementType::VOLTA,
+        ElementType::VOLTA_SEGMENT,
+        ElementType::SYSTEM_TEXT,
+        ElementType::REHEARSAL_MARK,
+        ElementType::JUMP,
+        ElementType::MARKER,
+        ElementType::FERMATA,
+        ElementType::BREATH,
+    };
+
+    static const std::unordered_set<Pid> SYSTEM_PROPERTIES {
+        Pid::REPEAT_START,
+        Pid::REPEAT_END,
+        Pid::REPEAT_JUMP,
+        Pid::REPEAT_COUNT,
+    };
+
+    if (!range.isValidBoundary() || !range.changedStyleIdSet.empty()) {
+        return true;
+    }
+
+    for (ElementType type : range.changedTypes) {
+        if (muse::contains(SYSTEM_TYPES, type)) {
+            return true;
+        }
+    }
+
+    for (Pid pid : range.changedPropertyIdSet) {
+        if (muse::contains(SYSTEM_PROPERTIES, pid)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool excerptContainsStaves(const Excerpt* excerpt, staff_idx_t staffIdxFrom, staff_idx_t staffIdxTo)
+{
+    for (const Part* part : excerpt->parts()) {
+        for (const Staff* staff : part->staves()) {
+            staff_idx_t idx = staff->idx();
+            if (idx >= staffIdxFrom && idx <= staffIdxTo) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void MasterNotation::invalidateExcerptsLayout(const ScoreChangesRange& range)
+{
+    // only the parts touched by the change are marked dirty; they are laid out when opened
+    const bool allExcerpts = changesAllExcerpts(range);
+
+    for (const IExcerptNotationPtr& excerptNotation : m_excerpts) {
+        const Excerpt* excerpt = get_impl(excerptNotation)->excerpt();
+        if (!excerpt || !excerpt->excerptScore()) {
+            continue;
+        }
+
+        // open excerpts are laid out together with the master score
+        if (excerpt->excerptScore()->isOpen()) {
+            m_laidOutExcerptScores.insert(excerpt->excerptScore());
+            continue;
+        }
+
+        if (allExcerpts || excerptContainsStaves(excerpt, range.staffIdxFrom, range.staffIdxTo)) {
+            m_laidOutExcerptScores.erase(excerpt->excerptScore());
+        }
+    }
+}
+
 const ExcerptNotationList& MasterNotation::potentialExcerpts() const
 {
     updatePotentialExcerpts();
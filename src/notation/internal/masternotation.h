@@ -23,6 +23,7 @@
 #define MU_NOTATION_MASTERNOTATION_H
 
 #include <memory>
+#include <unordered_set>
 
 #include "async/notification.h"
 
@@ -88,6 +89,8 @@ private:
 
     void onPartsChanged();
 
+    void invalidateExcerptsLayout(const engraving::ScoreChangesRange& range);
+
     void notifyAboutNeedSaveChanged();
 
     void markScoreAsNeedToSave();
@@ -104,6 +107,10 @@ private:
     // we need to regenerate potential excerpts, even though for all part IDs a
     // potential excerpt already exists.
     mutable bool m_potentialExcerptsForcedDirty = false;
+
+    //! NOTE Closed excerpts are not laid out on edits (see Score::endCmd),
+    //! they are laid out when opened, unless no edit touched them since their last layout
+    std::unordered_set<const engraving::Score*> m_laidOutExcerptScores;
 };
 
 using MasterNotationPtr = std::shared_ptr<MasterNotation>;
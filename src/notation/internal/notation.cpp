@@ -25,6 +25,7 @@
 #include <QScreen>
 
 #include "engraving/dom/masterscore.h"
+#include "engraving/dom/undo.h"
 
 #include "notationpainting.h"
 #include "notationviewstate.h"
@@ -44,6 +45,11 @@
 using namespace mu::notation;
 using namespace mu::engraving;
 
+//! NOTE With the lazy page layout enabled, an edit lays out this many pages,
+//! the following ones are laid out in small steps when idle
+static constexpr size_t LAZY_LAYOUT_PAGES = 3;
+static constexpr int PROVISIONAL_PAGES_LAYOUT_DELAY_MS = 50;
+
 Notation::Notation(const muse::modularity::ContextPtr& iocCtx, mu::engraving::Score* score)
     : muse::Injectable(iocCtx)
 {
@@ -90,6 +96,15 @@ Notation::Notation(const muse::modularity::ContextPtr& iocCtx, mu::engraving::Sc
         notifyAboutNotationChanged();
     });
 
+    m_notationChanged.onNotify(this, [this]() {
+        scheduleProvisionalPagesLayout();
+    });
+
+    m_provisionalPagesLayoutTimer.setSingleShot(true);
+    QObject::connect(&m_provisionalPagesLayoutTimer, &QTimer::timeout, [this]() {
+        layoutProvisionalPages();
+    });
+
     configuration()->canvasOrientation().ch.onReceive(this, [this](muse::Orientation) {
         if (m_score && m_score->autoLayoutEnabled()) {
             m_score->doLayout();
@@ -101,6 +116,8 @@ Notation::Notation(const muse::modularity::ContextPtr& iocCtx, mu::engraving::Sc
 
 Notation::~Notation()
 {
+    m_provisionalPagesLayoutTimer.stop();
+
     //! Note Dereference internal pointers before the deallocation of mu::engraving::Score* in order to prevent access to dereferenced object
     //! Makes sense to use std::shared_ptr<mu::engraving::Score*> ubiquitous instead of the raw pointers
     m_parts = nullptr;
@@ -124,9 +141,39 @@ void Notation::setScore(Score* score)
     }
 
     m_score = score;
+    if (m_score && configuration()->isLazyPageLayoutEnabled()) {
+        m_score->setLazyLayoutPages(LAZY_LAYOUT_PAGES);
+    }
     m_scoreInited.notify();
 }
 
+void Notation::scheduleProvisionalPagesLayout()
+{
+    if (m_score && m_score->hasProvisionalPages()) {
+        // restarts the timer if it is already running, so editing keeps postponing the layout
+        m_provisionalPagesLayoutTimer.start(PROVISIONAL_PAGES_LAYOUT_DELAY_MS);
+    }
+}
+
+void Notation::layoutProvisionalPages()
+{
+    if (!m_score || !m_score->hasProvisionalPages()) {
+        return;
+    }
+
+    // an edit is in progress (e.g. text editing), the end of it will reschedule the layout
+    if (m_score->undoStack()->active()) {
+        return;
+    }
+
+    TRACEFUNC;
+
+    m_score->layoutProvisionalPages();
+
+    // schedules the next step, if there are provisional pages left
+    notifyAboutNotationChanged();
+}
+
 muse::async::Notification Notation::scoreInited() const
 {
     return m_scoreInited;
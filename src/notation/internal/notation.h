@@ -22,6 +22,8 @@
 #ifndef MU_NOTATION_NOTATION_H
 #define MU_NOTATION_NOTATION_H
 
+#include <QTimer>
+
 #include "async/asyncable.h"
 #include "modularity/ioc.h"
 #include "iengravingconfiguration.h"
@@ -84,6 +86,9 @@ protected:
 
     void notifyAboutNotationChanged();
 
+    void scheduleProvisionalPagesLayout();
+    void layoutProvisionalPages();
+
     INotationPartsPtr m_parts = nullptr;
     INotationUndoStackPtr m_undoStack = nullptr;
     muse::async::Notification m_notationChanged;
@@ -105,6 +110,8 @@ private:
     INotationMidiInputPtr m_midiInput = nullptr;
     INotationAccessibilityPtr m_accessibility = nullptr;
     INotationElementsPtr m_elements = nullptr;
+
+    QTimer m_provisionalPagesLayoutTimer;
 };
 }
 
@@ -72,6 +72,8 @@ static const Settings::Key IS_LIMIT_CANVAS_SCROLL_AREA_KEY(module_name, "ui/canv
 
 static const Settings::Key COLOR_NOTES_OUTSIDE_OF_USABLE_PITCH_RANGE(module_name, "score/note/warnPitchRange");
 static const Settings::Key WARN_GUITAR_BENDS(module_name, "score/note/warnGuitarBends");
+static const Settings::Key IS_LAZY_PAGE_LAYOUT_ENABLED(module_name, "score/layout/lazyPageLayout");
+static const Settings::Key IS_LAZY_IMAGE_LOADING_ENABLED(module_name, "score/io/lazyImageLoading");
 static const Settings::Key REALTIME_DELAY(module_name, "io/midi/realtimeDelay");
 static const Settings::Key NOTE_DEFAULT_PLAY_DURATION(module_name, "score/note/defaultPlayDuration");
 
@@ -187,6 +189,8 @@ void NotationConfiguration::init()
 
     settings()->setDefaultValue(COLOR_NOTES_OUTSIDE_OF_USABLE_PITCH_RANGE, Val(true));
     settings()->setDefaultValue(WARN_GUITAR_BENDS, Val(true));
+    settings()->setDefaultValue(IS_LAZY_PAGE_LAYOUT_ENABLED, Val(false));
+    settings()->setDefaultValue(IS_LAZY_IMAGE_LOADING_ENABLED, Val(false));
     settings()->setDefaultValue(REALTIME_DELAY, Val(750));
     settings()->setDefaultValue(NOTE_DEFAULT_PLAY_DURATION, Val(500));
 
@@ -221,6 +225,7 @@ void NotationConfiguration::init()
     mu::engraving::MScore::warnPitchRange = colorNotesOutsideOfUsablePitchRange();
     mu::engraving::MScore::warnGuitarBends = warnGuitarBends();
     mu::engraving::MScore::defaultPlayDuration = notePlayDurationMilliseconds();
+    mu::engraving::MScore::lazyLoadImages = isLazyImageLoadingEnabled();
 
     mu::engraving::MScore::setHRaster(DEFAULT_GRID_SIZE_SPATIUM);
     mu::engraving::MScore::setVRaster(DEFAULT_GRID_SIZE_SPATIUM);
@@ -682,6 +687,27 @@ void NotationConfiguration::setWarnGuitarBends(bool value)
     settings()->setSharedValue(WARN_GUITAR_BENDS, Val(value));
 }
 
+bool NotationConfiguration::isLazyPageLayoutEnabled() const
+{
+    return settings()->value(IS_LAZY_PAGE_LAYOUT_ENABLED).toBool();
+}
+
+void NotationConfiguration::setIsLazyPageLayoutEnabled(bool enabled)
+{
+    settings()->setSharedValue(IS_LAZY_PAGE_LAYOUT_ENABLED, Val(enabled));
+}
+
+bool NotationConfiguration::isLazyImageLoadingEnabled() const
+{
+    return settings()->value(IS_LAZY_IMAGE_LOADING_ENABLED).toBool();
+}
+
+void NotationConfiguration::setIsLazyImageLoadingEnabled(bool enabled)
+{
+    mu::engraving::MScore::lazyLoadImages = enabled;
+    settings()->setSharedValue(IS_LAZY_IMAGE_LOADING_ENABLED, Val(enabled));
+}
+
 int NotationConfiguration::delayBetweenNotesInRealTimeModeMilliseconds() const
 {
     return settings()->value(REALTIME_DELAY).toInt();
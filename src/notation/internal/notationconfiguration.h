@@ -157,6 +157,12 @@ public:
     bool warnGuitarBends() const override;
     void setWarnGuitarBends(bool value) override;
 
+    bool isLazyPageLayoutEnabled() const override;
+    void setIsLazyPageLayoutEnabled(bool enabled) override;
+
+    bool isLazyImageLoadingEnabled() const override;
+    void setIsLazyImageLoadingEnabled(bool enabled) override;
+
     int delayBetweenNotesInRealTimeModeMilliseconds() const override;
     void setDelayBetweenNotesInRealTimeModeMilliseconds(int delayMs) override;
 
@@ -296,6 +296,9 @@ void NotationInteraction::notifyAboutSelectionChangedIfNeed()
 
     score()->setSelectionChanged(false);
 
+    // navigation can move the selection beyond the laid out pages of the lazy page layout
+    score()->layoutSelectionIfProvisional();
+
     m_selectionChanged.notify();
 }
 
@@ -1782,10 +1785,14 @@ bool NotationInteraction::applyPaletteElement(mu::engraving::EngravingItem* elem
                     || toActionIcon(element)->actionType() == mu::engraving::ActionIconType::MEASURE
                     || toActionIcon(element)->actionType() == mu::engraving::ActionIconType::BRACKETS))) {
             Measure* last = sel.endSegment() ? sel.endSegment()->measure() : nullptr;
+            // the drop positions need the whole range laid out
+            score->layoutProvisionalPagesUpTo(sel.tickEnd());
             for (Measure* m = sel.startSegment()->measure(); m; m = m->nextMeasureMM()) {
                 RectF r = m->staffabbox(sel.staffStart());
                 PointF pt(r.x() + r.width() * .5, r.y() + r.height() * .5);
-                pt += m->system()->page()->pos();
+                if (m->system() && m->system()->page()) {
+                    pt += m->system()->page()->pos();
+                }
                 applyDropPaletteElement(score, m, element, modifiers, pt);
                 if ((m == last) || (element->type() == ElementType::BRACKET)) {
                     break;
@@ -2633,14 +2640,16 @@ void NotationInteraction::expandSelection(ExpandSelectionMode mode)
     ChordRest* el = 0;
     switch (mode) {
     case ExpandSelectionMode::BeginSystem: {
-        Measure* measure = cr->segment()->measure()->system()->firstMeasure();
+        const System* system = cr->segment()->measure()->system();
+        Measure* measure = system ? system->firstMeasure() : nullptr;
         if (measure) {
             el = measure->first()->nextChordRest(cr->track());
         }
         break;
     }
     case ExpandSelectionMode::EndSystem: {
-        Measure* measure = cr->segment()->measure()->system()->lastMeasure();
+        const System* system = cr->segment()->measure()->system();
+        Measure* measure = system ? system->lastMeasure() : nullptr;
         if (measure) {
             el = measure->last()->nextChordRest(cr->track(), true);
         }
@@ -82,6 +82,11 @@ int NotationPainting::pageCount() const
         return 0;
     }
 
+    // the page count is used for printing and export, so it must be final
+    if (score()->hasProvisionalPages()) {
+        score()->layoutProvisionalPages(true);
+    }
+
     return static_cast<int>(score()->npages());
 }
 
@@ -117,6 +122,11 @@ void NotationPainting::doPaint(Painter* painter, const Options& opt)
         return;
     }
 
+    // printing and export need the complete layout
+    if (opt.isPrinting && score()->hasProvisionalPages()) {
+        score()->layoutProvisionalPages(true);
+    }
+
     Options myopt = opt;
     bool printPageBackground = myopt.printPageBackground;
     myopt.onPaintPageSheet = [this, printPageBackground](Painter* painter, const Page* page, const RectF& pageRect) {
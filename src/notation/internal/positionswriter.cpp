@@ -108,6 +108,11 @@ Ret PositionsWriter::write(INotationPtr notation, io::IODevice& destinationDevic
         return make_ret(Ret::Code::UnknownError);
     }
 
+    // the positions of all measures are written, so the layout must be complete
+    if (score->hasProvisionalPages()) {
+        score->layoutProvisionalPages(true);
+    }
+
     QByteArray qdata;
     QBuffer buf(&qdata);
     buf.open(QIODevice::WriteOnly);
@@ -193,13 +198,20 @@ void PositionsWriter::writeSegmentsPositions(deprecated::XmlWriter& writer, cons
             }
         }
 
+        const System* system = segment->measure()->system();
+        if (!system) {
+            // keep the ids in sync with elementIds()
+            id++;
+            continue;
+        }
+
         sx *= ndpi;
-        qreal sy = segment->measure()->system()->height() * ndpi;
+        qreal sy = system->height() * ndpi;
 
         int x = segment->pagePos().x() * ndpi;
         int y = segment->pagePos().y() * ndpi;
 
-        Page* page = segment->measure()->system()->page();
+        Page* page = system->page();
         page_idx_t pageIndex = score->pageIdx(page);
 
         writeElementPosition(writer, std::to_string(id), PointF(x, y), PointF(sx, sy), pageIndex);
@@ -214,12 +226,19 @@ void PositionsWriter::writeMeasuresPositions(deprecated::XmlWriter& writer, cons
     qreal ndpi = pngDpiResolution();
 
     for (Measure* measure = score->firstMeasureMM(); measure; measure = measure->nextMeasureMM()) {
+        const System* system = measure->system();
+        if (!system) {
+            // keep the ids in sync with elementIds()
+            id++;
+            continue;
+        }
+
         qreal sx = measure->ldata()->bbox().width() * ndpi;
-        qreal sy = measure->system()->height() * ndpi;
+        qreal sy = system->height() * ndpi;
         qreal x = measure->pagePos().x() * ndpi;
-        qreal y = measure->system()->pagePos().y() * ndpi;
+        qreal y = system->pagePos().y() * ndpi;
 
-        Page* page = measure->system()->page();
+        Page* page = system->page();
         page_idx_t pageIndex = score->pageIdx(page);
 
         writeElementPosition(writer, std::to_string(id), PointF(x, y), PointF(sx, sy), pageIndex);
@@ -142,6 +142,12 @@ public:
     MOCK_METHOD(bool, warnGuitarBends, (), (const, override));
     MOCK_METHOD(void, setWarnGuitarBends, (bool), (override));
 
+    MOCK_METHOD(bool, isLazyPageLayoutEnabled, (), (const, override));
+    MOCK_METHOD(void, setIsLazyPageLayoutEnabled, (bool), (override));
+
+    MOCK_METHOD(bool, isLazyImageLoadingEnabled, (), (const, override));
+    MOCK_METHOD(void, setIsLazyImageLoadingEnabled, (bool), (override));
+
     MOCK_METHOD(int, delayBetweenNotesInRealTimeModeMilliseconds, (), (const, override));
     MOCK_METHOD(void, setDelayBetweenNotesInRealTimeModeMilliseconds, (int), (override));
 
@@ -23,6 +23,9 @@
 
 #include <sstream>
 
+#include <QJsonDocument>
+#include <QJsonObject>
+
 #include "io/buffer.h"
 
 #include "stringutils.h"
@@ -45,12 +48,9 @@ RetVal<ProjectMeta> MscMetaReader::readMeta(const muse::io::path_t& filePath) co
     }
 
     // Read score meta
-    ByteArray scoreData = msczReader.readScoreFile();
-    deprecated::XmlReader xmlReader(scoreData.toQByteArray());
-
     RetVal<ProjectMeta> meta;
     meta.ret = make_ok();
-    doReadMeta(xmlReader, meta.val);
+    doReadMeta(msczReader, meta.val);
 
     // Read thumbnail
     ByteArray thumbnailData = msczReader.readThumbnailFile();
@@ -76,11 +76,8 @@ muse::RetVal<CloudProjectInfo> MscMetaReader::readCloudProjectInfo(const muse::i
     }
 
     // Read score meta
-    ByteArray scoreData = msczReader.readScoreFile();
-    deprecated::XmlReader xmlReader(scoreData.toQByteArray());
-
     ProjectMeta meta;
-    doReadMeta(xmlReader, meta);
+    doReadMeta(msczReader, meta);
 
     RetVal<CloudProjectInfo> info;
     info.ret = make_ok();
@@ -187,24 +184,7 @@ MscMetaReader::RawMeta MscMetaReader::doReadRawMeta(deprecated::XmlReader& xmlRe
             meta.titleTag = QString::fromStdString(xmlReader.readString());
         } else if (tag == "metaTag") {
             std::string name = xmlReader.attribute("name");
-
-            if (name == "workTitle") {
-                meta.titleAttribute = readMetaTagText(xmlReader);
-            } else if (name == "composer") {
-                meta.composerAttribute = readMetaTagText(xmlReader);
-            } else if (name == "arranger") {
-                meta.arranger = readMetaTagText(xmlReader);
-            } else if (name == "lyricist") {
-                meta.lyricistAttribute = readMetaTagText(xmlReader);
-            } else if (name == "copyright") {
-                meta.copyright = readMetaTagText(xmlReader);
-            } else if (name == "translator") {
-                meta.translator = readMetaTagText(xmlReader);
-            } else if (name == "creationDate") {
-                meta.creationDate = readMetaTagText(xmlReader);
-            } else {
-                meta.additionalTags[QString::fromStdString(name)] = readMetaTagText(xmlReader);
-            }
+            setMetaTag(meta, name, readMetaTagText(xmlReader));
         } else if (tag == "Staff") {
             if (meta.titleStyle.isEmpty()) {
                 while (xmlReader.readNextStartElement()) {
@@ -242,28 +222,80 @@ MscMetaReader::RawMeta MscMetaReader::doReadRawMeta(deprecated::XmlReader& xmlRe
     return meta;
 }
 
-void MscMetaReader::doReadMeta(deprecated::XmlReader& xmlReader, ProjectMeta& meta) const
+MscMetaReader::RawMeta MscMetaReader::doReadRawMetaJson(const QByteArray& json) const
+{
+    RawMeta meta;
+
+    QJsonObject rootObj = QJsonDocument::fromJson(json).object();
+
+    meta.titleStyle = rootObj.value("title").toString();
+    meta.subtitleStyle = rootObj.value("subtitle").toString();
+    meta.composerStyle = rootObj.value("composer").toString();
+    meta.lyricistStyle = rootObj.value("lyricist").toString();
+
+    QJsonObject metaTagsObj = rootObj.value("metaTags").toObject();
+    for (auto it = metaTagsObj.constBegin(); it != metaTagsObj.constEnd(); ++it) {
+        setMetaTag(meta, it.key().toStdString(), it.value().toString());
+    }
+
+    meta.partsCount = static_cast<size_t>(rootObj.value("partsCount").toInt());
+
+    return meta;
+}
+
+void MscMetaReader::setMetaTag(RawMeta& meta, const std::string& name, const QString& value) const
+{
+    if (name == "workTitle") {
+        meta.titleAttribute = value;
+    } else if (name == "composer") {
+        meta.composerAttribute = value;
+    } else if (name == "arranger") {
+        meta.arranger = value;
+    } else if (name == "lyricist") {
+        meta.lyricistAttribute = value;
+    } else if (name == "copyright") {
+        meta.copyright = value;
+    } else if (name == "translator") {
+        meta.translator = value;
+    } else if (name == "creationDate") {
+        meta.creationDate = value;
+    } else {
+        meta.additionalTags[QString::fromStdString(name)] = value;
+    }
+}
+
+void MscMetaReader::doReadMeta(const MscReader& msczReader, ProjectMeta& meta) const
 {
     RawMeta rawMeta;
 
-    while (xmlReader.readNextStartElement()) {
-        if (xmlReader.tagName() == "museScore") {
-            std::string version = xmlReader.attribute("version");
-            bool suitedVersion = version.rfind("1", 0) == 0;
+    //! NOTE Newer files also store the meta in a small separate file (see MscSaver),
+    //! only the files saved by older versions need the score file to be scanned
+    ByteArray metaData = msczReader.readScoreMetaJsonFile();
+    if (!metaData.empty()) {
+        rawMeta = doReadRawMetaJson(metaData.toQByteArrayNoCopy());
+    } else {
+        ByteArray scoreData = msczReader.readScoreFile();
+        deprecated::XmlReader xmlReader(scoreData.toQByteArray());
 
-            if (suitedVersion) {
-                rawMeta = doReadRawMeta(xmlReader);
-            } else {
-                while (xmlReader.readNextStartElement()) {
-                    if (xmlReader.tagName() == "Score") {
-                        rawMeta = doReadRawMeta(xmlReader);
-                    } else {
-                        xmlReader.skipCurrentElement();
+        while (xmlReader.readNextStartElement()) {
+            if (xmlReader.tagName() == "museScore") {
+                std::string version = xmlReader.attribute("version");
+                bool suitedVersion = version.rfind("1", 0) == 0;
+
+                if (suitedVersion) {
+                    rawMeta = doReadRawMeta(xmlReader);
+                } else {
+                    while (xmlReader.readNextStartElement()) {
+                        if (xmlReader.tagName() == "Score") {
+                            rawMeta = doReadRawMeta(xmlReader);
+                        } else {
+                            xmlReader.skipCurrentElement();
+                        }
                     }
                 }
+            } else {
+                xmlReader.skipCurrentElement();
             }
-        } else {
-            xmlReader.skipCurrentElement();
         }
     }
 
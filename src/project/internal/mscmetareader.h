@@ -72,9 +72,11 @@ private:
 
     muse::Ret prepareReader(const muse::io::path_t& filePath, mu::engraving::MscReader& reader) const;
 
-    void doReadMeta(muse::deprecated::XmlReader& xmlReader, ProjectMeta& meta) const;
+    void doReadMeta(const mu::engraving::MscReader& msczReader, ProjectMeta& meta) const;
     RawMeta doReadBox(muse::deprecated::XmlReader& xmlReader) const;
     RawMeta doReadRawMeta(muse::deprecated::XmlReader& xmlReader) const;
+    RawMeta doReadRawMetaJson(const QByteArray& json) const;
+    void setMetaTag(RawMeta& meta, const std::string& name, const QString& value) const;
     QString formatFromXml(const std::string& xml) const;
 
     QString format(const std::string& str) const;
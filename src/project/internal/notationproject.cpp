@@ -148,6 +148,7 @@ Ret NotationProject::doLoad(const muse::io::path_t& path, const muse::io::path_t
     IF_ASSERT_FAILED(params.mode != MscIoMode::Unknown) {
         return make_ret(Ret::Code::InternalError);
     }
+    params.useCache = configuration()->isOpenCacheEnabled();
 
     MscReader reader(params);
     Ret ret = reader.open();
@@ -504,7 +505,7 @@ Ret NotationProject::save(const muse::io::path_t& path, SaveMode saveMode)
             suffix = engraving::MSCX;
         }
 
-        return saveScore(path, suffix, false /*generateBackup*/, false /*createThumbnail*/);
+        return saveScore(path, suffix, false /*generateBackup*/, false /*createThumbnail*/, true /*isAutoSave*/);
     }
 
     return make_ret(notation::Err::UnknownError);
@@ -550,7 +551,8 @@ Ret NotationProject::writeToDevice(QIODevice* device)
     return ret;
 }
 
-Ret NotationProject::saveScore(const muse::io::path_t& path, const std::string& fileSuffix, bool generateBackup, bool createThumbnail)
+Ret NotationProject::saveScore(const muse::io::path_t& path, const std::string& fileSuffix, bool generateBackup, bool createThumbnail,
+                               bool isAutoSave)
 {
     if (!isMuseScoreFile(fileSuffix) && !fileSuffix.empty()) {
         return exportProject(path, fileSuffix);
@@ -558,10 +560,11 @@ Ret NotationProject::saveScore(const muse::io::path_t& path, const std::string&
 
     MscIoMode ioMode = mscIoModeBySuffix(fileSuffix);
 
-    return doSave(path, ioMode, generateBackup, createThumbnail);
+    return doSave(path, ioMode, generateBackup, createThumbnail, isAutoSave);
 }
 
-Ret NotationProject::doSave(const muse::io::path_t& path, engraving::MscIoMode ioMode, bool generateBackup, bool createThumbnail)
+Ret NotationProject::doSave(const muse::io::path_t& path, engraving::MscIoMode ioMode, bool generateBackup, bool createThumbnail,
+                            bool isAutoSave)
 {
     TRACEFUNC;
 
@@ -598,7 +601,7 @@ Ret NotationProject::doSave(const muse::io::path_t& path, engraving::MscIoMode i
         }
 
         MscWriter msczWriter(params);
-        Ret ret = writeProject(msczWriter, false /*onlySelection*/, createThumbnail);
+        Ret ret = writeProject(msczWriter, false /*onlySelection*/, createThumbnail, isAutoSave);
         msczWriter.close();
 
         if (!ret) {
@@ -704,7 +707,7 @@ Ret NotationProject::makeCurrentFileAsBackup()
     return ret;
 }
 
-Ret NotationProject::writeProject(MscWriter& msczWriter, bool onlySelection, bool createThumbnail)
+Ret NotationProject::writeProject(MscWriter& msczWriter, bool onlySelection, bool createThumbnail, bool isAutoSave)
 {
     TRACEFUNC;
 
@@ -716,7 +719,9 @@ Ret NotationProject::writeProject(MscWriter& msczWriter, bool onlySelection, boo
     }
 
     // Write engraving project
-    ret = m_engravingProject->writeMscz(msczWriter, onlySelection, createThumbnail);
+    //! NOTE Autosave is frequent, so the excerpts that weren't edited since the previous one are not serialized again
+    bool reuseUnchangedExcerpts = isAutoSave && configuration()->isIncrementalAutoSaveEnabled();
+    ret = m_engravingProject->writeMscz(msczWriter, onlySelection, createThumbnail, reuseUnchangedExcerpts);
     if (!ret) {
         LOGE() << "failed write engraving project to mscz: " << ret.toString();
         return make_ret(notation::Err::UnknownError);
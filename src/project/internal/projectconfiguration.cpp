@@ -53,6 +53,8 @@ static const Settings::Key PREFERRED_SCORE_CREATION_MODE_KEY(module_name, "proje
 static const Settings::Key MIGRATION_OPTIONS(module_name, "project/migration");
 static const Settings::Key AUTOSAVE_ENABLED_KEY(module_name, "project/autoSaveEnabled");
 static const Settings::Key AUTOSAVE_INTERVAL_KEY(module_name, "project/autoSaveInterval");
+static const Settings::Key INCREMENTAL_AUTOSAVE_ENABLED_KEY(module_name, "project/incrementalAutoSaveEnabled");
+static const Settings::Key OPEN_CACHE_ENABLED_KEY(module_name, "project/openCacheEnabled");
 static const Settings::Key ALSO_SHARE_AUDIO_COM_AFTER_PUBLISH(module_name, "project/alsoShareAudioCom");
 static const Settings::Key SHOW_ALSO_SHARE_AUDIO_COM_DIALOG(module_name, "project/showAlsoShareAudioComDialog");
 static const Settings::Key HAS_ASKED_ALSO_SHARE_AUDIO_COM(module_name, "project/hasAskedAlsoShareAudioCom");
@@ -96,6 +98,9 @@ void ProjectConfiguration::init()
         m_autoSaveEnabledChanged.send(val.toBool());
     });
 
+    settings()->setDefaultValue(INCREMENTAL_AUTOSAVE_ENABLED_KEY, Val(true));
+    settings()->setDefaultValue(OPEN_CACHE_ENABLED_KEY, Val(false));
+
     settings()->setDefaultValue(AUTOSAVE_INTERVAL_KEY, Val(5));
     settings()->valueChanged(AUTOSAVE_INTERVAL_KEY).onReceive(nullptr, [this](const Val& val) {
         m_autoSaveIntervalChanged.send(val.toInt());
@@ -525,6 +530,26 @@ muse::async::Channel<bool> ProjectConfiguration::autoSaveEnabledChanged() const
     return m_autoSaveEnabledChanged;
 }
 
+bool ProjectConfiguration::isIncrementalAutoSaveEnabled() const
+{
+    return settings()->value(INCREMENTAL_AUTOSAVE_ENABLED_KEY).toBool();
+}
+
+void ProjectConfiguration::setIncrementalAutoSaveEnabled(bool enabled)
+{
+    settings()->setSharedValue(INCREMENTAL_AUTOSAVE_ENABLED_KEY, Val(enabled));
+}
+
+bool ProjectConfiguration::isOpenCacheEnabled() const
+{
+    return settings()->value(OPEN_CACHE_ENABLED_KEY).toBool();
+}
+
+void ProjectConfiguration::setOpenCacheEnabled(bool enabled)
+{
+    settings()->setSharedValue(OPEN_CACHE_ENABLED_KEY, Val(enabled));
+}
+
 int ProjectConfiguration::autoSaveIntervalMinutes() const
 {
     return settings()->value(AUTOSAVE_INTERVAL_KEY).toInt();
@@ -111,6 +111,12 @@ public:
     void setAutoSaveEnabled(bool enabled) override;
     muse::async::Channel<bool> autoSaveEnabledChanged() const override;
 
+    bool isIncrementalAutoSaveEnabled() const override;
+    void setIncrementalAutoSaveEnabled(bool enabled) override;
+
+    bool isOpenCacheEnabled() const override;
+    void setOpenCacheEnabled(bool enabled) override;
+
     int autoSaveIntervalMinutes() const override;
     void setAutoSaveInterval(int minutes) override;
     muse::async::Channel<int> autoSaveIntervalChanged() const override;
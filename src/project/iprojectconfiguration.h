@@ -116,6 +116,12 @@ public:
     virtual void setAutoSaveEnabled(bool enabled) = 0;
     virtual muse::async::Channel<bool> autoSaveEnabledChanged() const = 0;
 
+    virtual bool isIncrementalAutoSaveEnabled() const = 0;
+    virtual void setIncrementalAutoSaveEnabled(bool enabled) = 0;
+
+    virtual bool isOpenCacheEnabled() const = 0;
+    virtual void setOpenCacheEnabled(bool enabled) = 0;
+
     virtual int autoSaveIntervalMinutes() const = 0;
     virtual void setAutoSaveInterval(int minutes) = 0;
     virtual muse::async::Channel<int> autoSaveIntervalChanged() const = 0;
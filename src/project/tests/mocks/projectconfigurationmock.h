@@ -93,6 +93,12 @@ public:
     MOCK_METHOD(void, setAutoSaveEnabled, (bool), (override));
     MOCK_METHOD(muse::async::Channel<bool>, autoSaveEnabledChanged, (), (const, override));
 
+    MOCK_METHOD(bool, isIncrementalAutoSaveEnabled, (), (const, override));
+    MOCK_METHOD(void, setIncrementalAutoSaveEnabled, (bool), (override));
+
+    MOCK_METHOD(bool, isOpenCacheEnabled, (), (const, override));
+    MOCK_METHOD(void, setOpenCacheEnabled, (bool), (override));
+
     MOCK_METHOD(int, autoSaveIntervalMinutes, (), (const, override));
     MOCK_METHOD(void, setAutoSaveInterval, (int), (override));
     MOCK_METHOD(muse::async::Channel<int>, autoSaveIntervalChanged, (), (const, override));
@@ -0,0 +1,110 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "project/internal/mscmetareader.h"
+
+#include "engraving/dom/masterscore.h"
+#include "engraving/infrastructure/mscreader.h"
+#include "engraving/infrastructure/mscwriter.h"
+#include "engraving/rw/mscsaver.h"
+#include "engraving/tests/utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::project;
+using namespace mu::engraving;
+using namespace muse;
+
+static const String SCOREMETA_SCORE_PATH(u"data/scoremeta.mscx");
+
+class Project_MscMetaReaderTest : public ::testing::Test
+{
+protected:
+    bool saveMscz(MasterScore* score, const String& filePath) const
+    {
+        MscWriter::Params params;
+        params.filePath = filePath;
+        params.mode = MscIoMode::Zip;
+
+        MscWriter writer(params);
+        writer.open();
+
+        MscSaver saver(score->iocContext());
+        bool ok = saver.writeMscz(score, writer, /*onlySelection*/ false, /*createThumbnail*/ false);
+        writer.close();
+
+        return ok && !writer.hasError();
+    }
+
+    //! NOTE Only the score file, like the files saved before the scoremeta.json entry was added
+    void copyScoreFileOnly(const String& srcFilePath, const String& dstFilePath) const
+    {
+        MscReader::Params readerParams;
+        readerParams.filePath = srcFilePath;
+        readerParams.mode = MscIoMode::Zip;
+
+        MscReader reader(readerParams);
+        reader.open();
+
+        MscWriter::Params writerParams;
+        writerParams.filePath = dstFilePath;
+        writerParams.mode = MscIoMode::Zip;
+
+        MscWriter writer(writerParams);
+        writer.open();
+        writer.writeScoreFile(reader.readScoreFile());
+    }
+};
+
+TEST_F(Project_MscMetaReaderTest, ScoreMetaJson_SameAsScoreFile)
+{
+    //! GIVEN A score with frame texts and meta tags, saved with the scoremeta.json entry
+    MasterScore* score = ScoreRW::readScore(SCOREMETA_SCORE_PATH);
+    ASSERT_TRUE(score);
+    ASSERT_TRUE(saveMscz(score, u"scoremeta_json.mscz"));
+    delete score;
+
+    //! GIVEN The same file without the entry
+    copyScoreFileOnly(u"scoremeta_json.mscz", u"scoremeta_xml.mscz");
+
+    //! DO Read the meta from both
+    MscMetaReader reader;
+    RetVal<ProjectMeta> jsonMeta = reader.readMeta(u"scoremeta_json.mscz");
+    RetVal<ProjectMeta> xmlMeta = reader.readMeta(u"scoremeta_xml.mscz");
+
+    ASSERT_TRUE(jsonMeta.ret);
+    ASSERT_TRUE(xmlMeta.ret);
+
+    //! CHECK The frame texts win over the meta tags
+    EXPECT_EQ(jsonMeta.val.title, QString("Test"));
+    EXPECT_EQ(jsonMeta.val.subtitle, QString("Split Measure+Slur"));
+    EXPECT_EQ(jsonMeta.val.composer, QString("Composer"));
+    EXPECT_EQ(jsonMeta.val.lyricist, QString("Lyricist"));
+    EXPECT_EQ(jsonMeta.val.arranger, QString("Arranger"));
+    EXPECT_EQ(jsonMeta.val.creationDate, QDate(2024, 3, 15));
+    EXPECT_EQ(jsonMeta.val.partsCount, 2u);
+
+    //! CHECK Both ways give the same meta
+    xmlMeta.val.filePath = jsonMeta.val.filePath;
+    EXPECT_TRUE(jsonMeta.val == xmlMeta.val);
+}
@@ -197,6 +197,24 @@ muse::async::Channel<bool> ProjectConfigurationStub::autoSaveEnabledChanged() co
     return ch;
 }
 
+bool ProjectConfigurationStub::isIncrementalAutoSaveEnabled() const
+{
+    return false;
+}
+
+void ProjectConfigurationStub::setIncrementalAutoSaveEnabled(bool)
+{
+}
+
+bool ProjectConfigurationStub::isOpenCacheEnabled() const
+{
+    return false;
+}
+
+void ProjectConfigurationStub::setOpenCacheEnabled(bool)
+{
+}
+
 int ProjectConfigurationStub::autoSaveIntervalMinutes() const
 {
     return 1;